@@ -5,41 +5,67 @@
 #include <cmath>
 #include <algorithm>
 
-StressStrainAnalysis::StressStrainAnalysis(StiffnessMatrix& mesh) : mesh(mesh) {}
+StressStrainAnalysis::StressStrainAnalysis(StiffnessMatrix& mesh)
+    : mesh(mesh), D(mesh.getConstitutiveMatrix()) {}
 
 std::vector<StressStrainAnalysis::ElementStressStrain> 
 StressStrainAnalysis::computeStressStrain(const std::vector<double>& U) {
     std::cout << "\n=== COMPUTING ELEMENT STRESSES AND STRAINS ===" << std::endl;
     
+    const int W = ElementKernel::BATCH;
     const auto& elements = mesh.getElements();
     const auto& nodes = mesh.getNodes();
-    std::vector<ElementStressStrain> results;
-    
-    for (const auto& elem : elements) {
-        ElementStressStrain ess;
-        ess.elementId = elem.id;
-        
-        // Compute element center
-        ess.centerX = 0.0;
-        ess.centerY = 0.0;
-        for (int i = 0; i < 4; i++) {
-            ess.centerX += nodes[elem.nodes[i]].x;
-            ess.centerY += nodes[elem.nodes[i]].y;
-        }
-        ess.centerX /= 4.0;
-        ess.centerY /= 4.0;
+    int numElements = elements.size();
+    std::vector<ElementStressStrain> results(numElements);
+    
+    // Strains at the element centres (xi=0, eta=0), one element per SIMD lane
+    for (int first = 0; first < numElements; first += W) {
+        int count = std::min(W, numElements - first);
+        int ids[ElementKernel::BATCH];
+        for (int l = 0; l < W; l++) ids[l] = first + (l < count ? l : 0);
         
-        // Compute strain at element center (xi=0, eta=0)
-        computeElementStrain(elem.id, U, ess.strainX, ess.strainY, ess.shearStrainXY);
+        ElementKernel::ElementBatch batch;
+        mesh.gatherElementBatch(ids, count, batch);
         
-        // Compute stress
-        computeStress(ess.strainX, ess.strainY, ess.shearStrainXY,
-                     ess.stressX, ess.stressY, ess.shearStressXY);
+        // Element displacement vectors
+        alignas(64) double Ue[8][ElementKernel::BATCH];
+        for (int l = 0; l < W; l++) {
+            const auto& elem = elements[ids[l]];
+            for (int i = 0; i < 4; i++) {
+                Ue[2*i][l] = U[2 * elem.nodes[i]];
+                Ue[2*i + 1][l] = U[2 * elem.nodes[i] + 1];
+            }
+        }
         
-        // Compute von Mises stress
-        ess.vonMisesStress = computeVonMises(ess.stressX, ess.stressY, ess.shearStressXY);
+        alignas(64) double strain[3][ElementKernel::BATCH];
+        ElementKernel::computeCentreStrainBatch(batch, Ue, strain);
         
-        results.push_back(ess);
+        for (int l = 0; l < count; l++) {
+            const auto& elem = elements[ids[l]];
+            ElementStressStrain& ess = results[ids[l]];
+            ess.elementId = elem.id;
+            
+            // Compute element center
+            ess.centerX = 0.0;
+            ess.centerY = 0.0;
+            for (int i = 0; i < 4; i++) {
+                ess.centerX += nodes[elem.nodes[i]].x;
+                ess.centerY += nodes[elem.nodes[i]].y;
+            }
+            ess.centerX /= 4.0;
+            ess.centerY /= 4.0;
+            
+            ess.strainX = strain[0][l];
+            ess.strainY = strain[1][l];
+            ess.shearStrainXY = strain[2][l];
+            
+            // Compute stress
+            computeStress(ess.strainX, ess.strainY, ess.shearStrainXY,
+                         ess.stressX, ess.stressY, ess.shearStressXY);
+            
+            // Compute von Mises stress
+            ess.vonMisesStress = computeVonMises(ess.stressX, ess.stressY, ess.shearStressXY);
+        }
     }
     
     std::cout << "Computed stresses for " << results.size() << " elements" << std::endl;
@@ -47,37 +73,8 @@ StressStrainAnalysis::computeStressStrain(const std::vector<double>& U) {
     return results;
 }
 
-void StressStrainAnalysis::computeElementStrain(int elemId, const std::vector<double>& U,
-                                                double& ex, double& ey, double& gxy) {
-    // Evaluate at element center (xi=0, eta=0)
-    std::vector<std::vector<double>> B;
-    mesh.computeBMatrix(0.0, 0.0, elemId, B);
-    
-    // Extract element displacement vector
-    const auto& elem = mesh.getElements()[elemId];
-    std::vector<double> Ue(8);
-    for (int i = 0; i < 4; i++) {
-        Ue[2*i] = U[2 * elem.nodes[i]];
-        Ue[2*i + 1] = U[2 * elem.nodes[i] + 1];
-    }
-    
-    // {strain} = [B]{Ue}
-    ex = 0.0;
-    ey = 0.0;
-    gxy = 0.0;
-    
-    for (int i = 0; i < 8; i++) {
-        ex += B[0][i] * Ue[i];
-        ey += B[1][i] * Ue[i];
-        gxy += B[2][i] * Ue[i];
-    }
-}
-
 void StressStrainAnalysis::computeStress(double ex, double ey, double gxy,
                                         double& sx, double& sy, double& txy) {
-    // Get constitutive matrix
-    auto D = mesh.getConstitutiveMatrix();
-    
     // {stress} = [D]{strain}
     sx = D[0][0] * ex + D[0][1] * ey;
     sy = D[1][0] * ex + D[1][1] * ey;
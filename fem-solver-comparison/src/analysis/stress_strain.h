@@ -29,10 +29,7 @@ public:
     
 private:
     StiffnessMatrix& mesh;
-    
-    // Compute element strain from displacement
-    void computeElementStrain(int elemId, const std::vector<double>& U,
-                             double& ex, double& ey, double& gxy);
+    std::vector<std::vector<double>> D;  // Constitutive matrix
     
     // Compute stress from strain
     void computeStress(double ex, double ey, double gxy,
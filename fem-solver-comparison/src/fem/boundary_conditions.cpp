@@ -6,10 +6,13 @@
 BoundaryConditions::BoundaryConditions(StiffnessMatrix& mesh) : mesh(mesh) {
     identifyBoundaryNodes();
     
-    // Get plate dimensions from first and last nodes
-    const auto& nodes = mesh.getNodes();
-    width = nodes.back().x;
-    height = nodes.back().y;
+    // Get plate dimensions from the node extents (independent of numbering)
+    width = 0.0;
+    height = 0.0;
+    for (const auto& node : mesh.getNodes()) {
+        width = std::max(width, node.x);
+        height = std::max(height, node.y);
+    }
 }
 
 void BoundaryConditions::identifyBoundaryNodes() {
@@ -46,7 +49,7 @@ void BoundaryConditions::identifyBoundaryNodes() {
     std::cout << "Right edge (loaded): " << rightEdgeNodes.size() << " nodes" << std::endl;
 }
 
-void BoundaryConditions::applyFixedBoundary(std::vector<std::vector<double>>& K, 
+void BoundaryConditions::applyFixedBoundary(DenseMatrix& K, 
                                             std::vector<double>& F) {
     // Fix left edge (u = 0, v = 0)
     for (int nodeId : leftEdgeNodes) {
@@ -54,7 +57,7 @@ void BoundaryConditions::applyFixedBoundary(std::vector<std::vector<double>>& K,
         int dof_v = 2 * nodeId + 1;
         
         // Set row to zero with 1 on diagonal
-        for (size_t j = 0; j < K[dof_u].size(); j++) {
+        for (int j = 0; j < K.cols(); j++) {
             K[dof_u][j] = 0.0;
             K[dof_v][j] = 0.0;
         }
@@ -62,7 +65,7 @@ void BoundaryConditions::applyFixedBoundary(std::vector<std::vector<double>>& K,
         K[dof_v][dof_v] = 1.0;
         
         // Set column to zero
-        for (size_t i = 0; i < K.size(); i++) {
+        for (int i = 0; i < K.rows(); i++) {
             if (i != dof_u) K[i][dof_u] = 0.0;
             if (i != dof_v) K[i][dof_v] = 0.0;
         }
@@ -72,6 +75,96 @@ void BoundaryConditions::applyFixedBoundary(std::vector<std::vector<double>>& K,
     }
 }
 
+std::vector<int> BoundaryConditions::getFixedDOFs() const {
+    std::vector<int> dofs;
+    for (int nodeId : leftEdgeNodes) {
+        dofs.push_back(2 * nodeId);
+        dofs.push_back(2 * nodeId + 1);
+    }
+    return dofs;
+}
+
+void BoundaryConditions::applyFixedBoundary(CSRMatrix& K, 
+                                            std::vector<double>& F) {
+    std::vector<bool> fixed(K.n, false);
+    for (int nodeId : leftEdgeNodes) {
+        fixed[2 * nodeId] = true;
+        fixed[2 * nodeId + 1] = true;
+        F[2 * nodeId] = 0.0;
+        F[2 * nodeId + 1] = 0.0;
+    }
+    
+    // Compact the matrix in place: fixed rows become identity rows and
+    // fixed columns are dropped from the remaining rows
+    int pos = 0;
+    int rowStart = 0;
+    for (int i = 0; i < K.n; i++) {
+        int rowEnd = K.rowPointers[i + 1];
+        
+        if (fixed[i]) {
+            K.values[pos] = 1.0;
+            K.colIndices[pos] = i;
+            pos++;
+        } else {
+            for (int k = rowStart; k < rowEnd; k++) {
+                if (!fixed[K.colIndices[k]]) {
+                    K.values[pos] = K.values[k];
+                    K.colIndices[pos] = K.colIndices[k];
+                    pos++;
+                }
+            }
+        }
+        
+        rowStart = rowEnd;
+        K.rowPointers[i + 1] = pos;
+    }
+    
+    K.values.resize(pos);
+    K.colIndices.resize(pos);
+}
+
+void BoundaryConditions::applyFixedBoundary(BSRMatrix& K, 
+                                            std::vector<double>& F) {
+    // The left edge fixes both u and v, so whole nodes are constrained
+    std::vector<bool> fixed(K.numBlockRows, false);
+    for (int nodeId : leftEdgeNodes) {
+        fixed[nodeId] = true;
+        F[2 * nodeId] = 0.0;
+        F[2 * nodeId + 1] = 0.0;
+    }
+    
+    // Compact in place as for CSR: a fixed node row keeps an identity block,
+    // other rows drop the blocks of fixed nodes
+    int pos = 0;
+    int rowStart = 0;
+    for (int I = 0; I < K.numBlockRows; I++) {
+        int rowEnd = K.rowPointers[I + 1];
+        
+        if (fixed[I]) {
+            K.colIndices[pos] = I;
+            K.values[4 * pos] = 1.0;
+            K.values[4 * pos + 1] = 0.0;
+            K.values[4 * pos + 2] = 0.0;
+            K.values[4 * pos + 3] = 1.0;
+            pos++;
+        } else {
+            for (int k = rowStart; k < rowEnd; k++) {
+                if (!fixed[K.colIndices[k]]) {
+                    K.colIndices[pos] = K.colIndices[k];
+                    for (int c = 0; c < 4; c++) K.values[4 * pos + c] = K.values[4 * k + c];
+                    pos++;
+                }
+            }
+        }
+        
+        rowStart = rowEnd;
+        K.rowPointers[I + 1] = pos;
+    }
+    
+    K.values.resize(4 * pos);
+    K.colIndices.resize(pos);
+}
+
 void BoundaryConditions::generateLoadVector(std::vector<double>& F, LoadCase loadCase) {
     const auto& nodes = mesh.getNodes();
     int ndof = 2 * nodes.size();
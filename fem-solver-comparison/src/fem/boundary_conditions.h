@@ -18,7 +18,16 @@ public:
     BoundaryConditions(StiffnessMatrix& mesh);
     
     // Apply boundary conditions (fixed left edge)
-    void applyFixedBoundary(std::vector<std::vector<double>>& K, 
+    void applyFixedBoundary(DenseMatrix& K, 
+                           std::vector<double>& F);
+    
+    // Apply boundary conditions to a CSR matrix (fixed rows keep only the diagonal)
+    void applyFixedBoundary(CSRMatrix& K, 
+                           std::vector<double>& F);
+    
+    // Apply boundary conditions to a 2x2 block CSR matrix: fixed nodes keep an identity
+    // diagonal block, fixed columns are zeroed and blocks left empty are dropped
+    void applyFixedBoundary(BSRMatrix& K, 
                            std::vector<double>& F);
     
     // Generate load vector for different cases
@@ -36,6 +45,9 @@ public:
     // Get left edge nodes (fixed)
     std::vector<int> getLeftEdgeNodes() const { return leftEdgeNodes; }
     
+    // Constrained DOFs (u and v of every fixed node)
+    std::vector<int> getFixedDOFs() const;
+    
 private:
     StiffnessMatrix& mesh;
     std::vector<int> leftEdgeNodes;
@@ -0,0 +1,16 @@
+#ifndef BSR_MATRIX_H
+#define BSR_MATRIX_H
+
+#include <vector>
+
+// Block CSR with 2x2 blocks, one per node-node coupling. Block (I, J) lives at
+// values[4 * k] for rowPointers[I] <= k < rowPointers[I + 1] with colIndices[k] = J,
+// stored column-major: a00, a10, a01, a11
+struct BSRMatrix {
+    std::vector<double> values;
+    std::vector<int> colIndices;
+    std::vector<int> rowPointers;
+    int numBlockRows;
+};
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef CSR_MATRIX_H
+#define CSR_MATRIX_H
+
+#include <vector>
+
+// Compressed sparse row storage: row i holds values[k] at column colIndices[k]
+// for rowPointers[i] <= k < rowPointers[i + 1]
+struct CSRMatrix {
+    std::vector<double> values;
+    std::vector<int> colIndices;
+    std::vector<int> rowPointers;
+    int n;
+};
+
+#endif
@@ -0,0 +1,128 @@
+#include "dense_kernels.h"
+#include <algorithm>
+#include <vector>
+
+void DenseKernels::microKernel(int k, const double* packedA, const double* packedB,
+                               double* C, size_t ldc, int rows, int cols) {
+    constexpr int NV = NR / SIMD_WIDTH;
+    SimdVec acc[MR][NV];
+    for (int r = 0; r < MR; r++) {
+        for (int v = 0; v < NV; v++) acc[r][v] = SimdVec::broadcast(0.0);
+    }
+    
+    for (int p = 0; p < k; p++) {
+        SimdVec b[NV];
+        for (int v = 0; v < NV; v++) b[v] = SimdVec::load(packedB + p * NR + v * SIMD_WIDTH);
+        for (int r = 0; r < MR; r++) {
+            SimdVec a = SimdVec::broadcast(packedA[p * MR + r]);
+            for (int v = 0; v < NV; v++) acc[r][v] = SimdVec::fmadd(a, b[v], acc[r][v]);
+        }
+    }
+    
+    // Full tiles go straight to C; edge tiles through a buffer
+    if (rows == MR && cols == NR) {
+        for (int r = 0; r < MR; r++) {
+            double* c = C + r * ldc;
+            for (int v = 0; v < NV; v++) {
+                (SimdVec::load(c + v * SIMD_WIDTH) - acc[r][v]).store(c + v * SIMD_WIDTH);
+            }
+        }
+    } else {
+        double tile[MR * NR];
+        for (int r = 0; r < MR; r++) {
+            for (int v = 0; v < NV; v++) acc[r][v].store(tile + r * NR + v * SIMD_WIDTH);
+        }
+        for (int r = 0; r < rows; r++) {
+            for (int c = 0; c < cols; c++) C[r * ldc + c] -= tile[r * NR + c];
+        }
+    }
+}
+
+void DenseKernels::gemmSubtract(DenseMatrix::ConstView A, DenseMatrix::ConstView B, bool transposeB,
+                                DenseMatrix::View C, const Tiling& tiling) {
+    int m = C.rows, n = C.cols, k = A.cols;
+    if (m == 0 || n == 0 || k == 0) return;
+    
+    int kc = std::max(1, tiling.panel);
+    int mc = std::max(MR, tiling.rowBlock / MR * MR);
+    int nc = std::max(NR, tiling.colBlock / NR * NR);
+    
+    // Packing buffers are kept per thread, so tile tasks do not allocate
+    thread_local std::vector<double> packedA, packedB;
+    size_t sizeA = (size_t)(std::min(mc, m) + MR) * std::min(kc, k);
+    size_t sizeB = (size_t)(std::min(nc, n) + NR) * std::min(kc, k);
+    if (packedA.size() < sizeA) packedA.resize(sizeA);
+    if (packedB.size() < sizeB) packedB.resize(sizeB);
+    
+    for (int jc = 0; jc < n; jc += nc) {
+        int ncols = std::min(nc, n - jc);
+        
+        for (int pc = 0; pc < k; pc += kc) {
+            int depth = std::min(kc, k - pc);
+            
+            // B slivers: NR columns, depth rows, zero-padded past the last column
+            for (int jr = 0; jr < ncols; jr += NR) {
+                double* dst = &packedB[(size_t)jr * depth];
+                int cols = std::min(NR, ncols - jr);
+                for (int p = 0; p < depth; p++) {
+                    for (int c = 0; c < NR; c++) {
+                        double value = 0.0;
+                        if (c < cols) {
+                            value = transposeB ? B(jc + jr + c, pc + p) : B(pc + p, jc + jr + c);
+                        }
+                        dst[p * NR + c] = value;
+                    }
+                }
+            }
+            
+            for (int ic = 0; ic < m; ic += mc) {
+                int nrows = std::min(mc, m - ic);
+                
+                // A slivers: MR rows, depth columns, zero-padded past the last row
+                for (int ir = 0; ir < nrows; ir += MR) {
+                    double* dst = &packedA[(size_t)ir * depth];
+                    int rows = std::min(MR, nrows - ir);
+                    for (int r = 0; r < MR; r++) {
+                        const double* a = r < rows ? A[ic + ir + r] + pc : nullptr;
+                        for (int p = 0; p < depth; p++) dst[p * MR + r] = a ? a[p] : 0.0;
+                    }
+                }
+                
+                for (int jr = 0; jr < ncols; jr += NR) {
+                    for (int ir = 0; ir < nrows; ir += MR) {
+                        microKernel(depth, &packedA[(size_t)ir * depth], &packedB[(size_t)jr * depth],
+                                    C[ic + ir] + jc + jr, C.stride,
+                                    std::min(MR, nrows - ir), std::min(NR, ncols - jr));
+                    }
+                }
+            }
+        }
+    }
+}
+
+void DenseKernels::trsmRightLowerTranspose(DenseMatrix::ConstView L, DenseMatrix::View B) {
+    for (int i = 0; i < B.rows; i++) {
+        double* Bi = B[i];
+        for (int j = 0; j < L.rows; j++) {
+            const double* Lj = L[j];
+            double sum = Bi[j];
+            for (int m = 0; m < j; m++) {
+                sum -= Bi[m] * Lj[m];
+            }
+            Bi[j] = sum / Lj[j];
+        }
+    }
+}
+
+void DenseKernels::trsmLeftUnitLower(DenseMatrix::ConstView L, DenseMatrix::View B) {
+    for (int r = 1; r < B.rows; r++) {
+        double* Br = B[r];
+        for (int m = 0; m < r; m++) {
+            double lrm = L(r, m);
+            const double* Bm = B[m];
+            for (int j = 0; j < B.cols; j++) {
+                Br[j] -= lrm * Bm[j];
+            }
+        }
+    }
+}
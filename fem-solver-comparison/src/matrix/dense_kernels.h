@@ -0,0 +1,42 @@
+#ifndef DENSE_KERNELS_H
+#define DENSE_KERNELS_H
+
+#include "dense_matrix.h"
+#include "simd_vec.h"
+
+// BLAS-3 building blocks for the blocked dense factorizations. The update
+// C -= A * B is split into cache tiles (rowBlock x depth of A in L2, depth x
+// colBlock of B in L3), both operands are packed into contiguous slivers, and a
+// register-blocked MR x NR micro-kernel accumulates each piece of C in SIMD
+// registers before touching memory.
+class DenseKernels {
+public:
+    static constexpr int MR = 4;                // Rows of C per micro-kernel call
+    static constexpr int NR = 2 * SIMD_WIDTH;   // Columns of C per micro-kernel call
+    
+    struct Tiling {
+        int panel;      // Panel width of the factorizations (and the GEMM depth)
+        int rowBlock;   // Rows of A packed at a time
+        int colBlock;   // Columns of B packed at a time
+    };
+    
+    static Tiling defaultTiling() { return {128, 128, 1024}; }
+    
+    // C -= A * B, or C -= A * B^T with transposeB. A is m x k, C is m x n and
+    // B is k x n (n x k when transposed).
+    static void gemmSubtract(DenseMatrix::ConstView A, DenseMatrix::ConstView B, bool transposeB,
+                             DenseMatrix::View C, const Tiling& tiling = defaultTiling());
+    
+    // B <- B L^-T for lower triangular L (the panel solve of Cholesky)
+    static void trsmRightLowerTranspose(DenseMatrix::ConstView L, DenseMatrix::View B);
+    
+    // B <- L^-1 B for unit lower triangular L (the U block row of LU)
+    static void trsmLeftUnitLower(DenseMatrix::ConstView L, DenseMatrix::View B);
+
+private:
+    // C(rows x cols) -= packedA * packedB over depth k; rows <= MR, cols <= NR
+    static void microKernel(int k, const double* packedA, const double* packedB,
+                            double* C, size_t ldc, int rows, int cols);
+};
+
+#endif
@@ -0,0 +1,100 @@
+#include "dense_matrix.h"
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <new>
+#include <utility>
+
+template<typename T>
+T* DenseMatrixT<T>::allocate(size_t count) {
+    if (count == 0) return nullptr;
+    
+    // aligned_alloc needs a size that is a multiple of the alignment, which the
+    // padded row length already guarantees
+    void* p = std::aligned_alloc(ALIGNMENT, count * sizeof(T));
+    if (!p) throw std::bad_alloc();
+    return static_cast<T*>(p);
+}
+
+template<typename T>
+void DenseMatrixT<T>::AlignedFree::operator()(T* p) const {
+    std::free(p);
+}
+
+template<typename T>
+DenseMatrixT<T>::DenseMatrixT(int rows, int cols, T value)
+    : numRows(rows), numCols(cols) {
+    const size_t lineElements = ALIGNMENT / sizeof(T);
+    ld = (cols + lineElements - 1) / lineElements * lineElements;
+    storage.reset(allocate((size_t)rows * ld));
+    fill(value);
+}
+
+template<typename T>
+DenseMatrixT<T>::DenseMatrixT(const DenseMatrixT& other)
+    : numRows(other.numRows), numCols(other.numCols), ld(other.ld),
+      storage(allocate((size_t)other.numRows * other.ld)) {
+    if (storage) std::memcpy(storage.get(), other.storage.get(), (size_t)numRows * ld * sizeof(T));
+}
+
+template<typename T>
+DenseMatrixT<T>::DenseMatrixT(DenseMatrixT&& other) noexcept
+    : numRows(other.numRows), numCols(other.numCols), ld(other.ld),
+      storage(std::move(other.storage)) {
+    other.numRows = other.numCols = 0;
+    other.ld = 0;
+}
+
+template<typename T>
+DenseMatrixT<T>& DenseMatrixT<T>::operator=(DenseMatrixT&& other) noexcept {
+    numRows = other.numRows;
+    numCols = other.numCols;
+    ld = other.ld;
+    storage = std::move(other.storage);
+    other.numRows = other.numCols = 0;
+    other.ld = 0;
+    return *this;
+}
+
+template<typename T>
+DenseMatrixT<T>& DenseMatrixT<T>::operator=(const DenseMatrixT& other) {
+    if (this == &other) return *this;
+    
+    // Reuse the allocation when the shape matches (e.g. refactoring the same K)
+    if ((size_t)numRows * ld != (size_t)other.numRows * other.ld) {
+        storage.reset(allocate((size_t)other.numRows * other.ld));
+    }
+    numRows = other.numRows;
+    numCols = other.numCols;
+    ld = other.ld;
+    if (storage) std::memcpy(storage.get(), other.storage.get(), (size_t)numRows * ld * sizeof(T));
+    
+    return *this;
+}
+
+template<typename T>
+void DenseMatrixT<T>::fill(T value) {
+    std::fill(storage.get(), storage.get() + (size_t)numRows * ld, value);
+}
+
+template<typename T>
+void DenseMatrixT<T>::swapRows(int a, int b) {
+    if (a == b) return;
+    std::swap_ranges((*this)[a], (*this)[a] + numCols, (*this)[b]);
+}
+
+template<typename T>
+void DenseMatrixT<T>::multiply(const std::vector<double>& x, std::vector<double>& y) const {
+    y.resize(numRows);
+    for (int i = 0; i < numRows; i++) {
+        const T* row = (*this)[i];
+        double sum = 0.0;
+        for (int j = 0; j < numCols; j++) {
+            sum += row[j] * x[j];
+        }
+        y[i] = sum;
+    }
+}
+
+template class DenseMatrixT<double>;
+template class DenseMatrixT<float>;
@@ -0,0 +1,98 @@
+#ifndef DENSE_MATRIX_H
+#define DENSE_MATRIX_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Rectangular window into row-major storage: element (i, j) is data[i * stride + j]
+template<typename T>
+struct StridedView {
+    T* data;
+    int rows;
+    int cols;
+    size_t stride;
+    
+    T* operator[](int i) const { return data + i * stride; }
+    T& operator()(int i, int j) const { return data[i * stride + j]; }
+    
+    // Sub-block of r x c entries starting at (i, j)
+    StridedView block(int i, int j, int r, int c) const { return {data + i * stride + j, r, c, stride}; }
+};
+
+// Dense row-major matrix in a single 64-byte-aligned allocation. Rows are padded
+// to a whole number of cache lines, so every row starts aligned and copies are one
+// memcpy. A[i] returns a pointer to row i, keeping the A[i][j] indexing of the
+// nested-vector code it replaces. Instantiated for double (DenseMatrix) and for
+// float (DenseMatrixF, single-precision factors).
+template<typename T>
+class DenseMatrixT {
+public:
+    static constexpr size_t ALIGNMENT = 64;
+    
+    using View = StridedView<T>;
+    using ConstView = StridedView<const T>;
+    
+    DenseMatrixT() : numRows(0), numCols(0), ld(0) {}
+    DenseMatrixT(int rows, int cols, T value = 0);
+    
+    // Element-wise conversion from another precision (rounds when narrowing)
+    template<typename U>
+    explicit DenseMatrixT(const DenseMatrixT<U>& other) : DenseMatrixT(other.rows(), other.cols()) {
+        for (int i = 0; i < numRows; i++) {
+            const U* src = other[i];
+            T* dst = (*this)[i];
+            for (int j = 0; j < numCols; j++) dst[j] = static_cast<T>(src[j]);
+        }
+    }
+    
+    DenseMatrixT(const DenseMatrixT& other);
+    DenseMatrixT(DenseMatrixT&& other) noexcept;
+    DenseMatrixT& operator=(const DenseMatrixT& other);
+    DenseMatrixT& operator=(DenseMatrixT&& other) noexcept;
+    
+    int rows() const { return numRows; }
+    int cols() const { return numCols; }
+    bool empty() const { return numRows == 0 || numCols == 0; }
+    
+    // Leading dimension in elements (cols rounded up to a cache line)
+    size_t stride() const { return ld; }
+    
+    T* data() { return storage.get(); }
+    const T* data() const { return storage.get(); }
+    
+    T* operator[](int i) { return storage.get() + i * ld; }
+    const T* operator[](int i) const { return storage.get() + i * ld; }
+    T& operator()(int i, int j) { return storage[i * ld + j]; }
+    T operator()(int i, int j) const { return storage[i * ld + j]; }
+    
+    View view() { return {data(), numRows, numCols, ld}; }
+    ConstView view() const { return {data(), numRows, numCols, ld}; }
+    View block(int i, int j, int r, int c) { return view().block(i, j, r, c); }
+    ConstView block(int i, int j, int r, int c) const { return view().block(i, j, r, c); }
+    
+    void fill(T value);
+    void swapRows(int a, int b);
+    
+    // y = A * x (accumulated in double)
+    void multiply(const std::vector<double>& x, std::vector<double>& y) const;
+    
+    // Bytes of the logical rows x cols entries (padding excluded)
+    double memoryBytes() const { return (double)numRows * numCols * sizeof(T); }
+
+private:
+    struct AlignedFree {
+        void operator()(T* p) const;
+    };
+    
+    int numRows, numCols;
+    size_t ld;
+    std::unique_ptr<T[], AlignedFree> storage;
+    
+    static T* allocate(size_t count);
+};
+
+using DenseMatrix = DenseMatrixT<double>;
+using DenseMatrixF = DenseMatrixT<float>;
+
+#endif
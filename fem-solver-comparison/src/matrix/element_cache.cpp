@@ -0,0 +1,48 @@
+#include "element_cache.h"
+#include <cmath>
+#include <cstring>
+
+ElementStiffnessCache::ElementStiffnessCache(double quantum)
+    : quantum(quantum), lookups(0), hits(0) {}
+
+ElementStiffnessCache::Key ElementStiffnessCache::makeKey(const double x[4], const double y[4],
+                                                          const ElementKernel::Matrix3& D,
+                                                          double t) const {
+    Key key;
+    for (int i = 1; i < 4; i++) {
+        key.geometry[2 * (i - 1)]     = std::llround((x[i] - x[0]) / quantum);
+        key.geometry[2 * (i - 1) + 1] = std::llround((y[i] - y[0]) / quantum);
+    }
+    for (int k = 0; k < 9; k++) key.material[k] = D[k];
+    key.material[9] = t;
+    return key;
+}
+
+std::size_t ElementStiffnessCache::KeyHash::operator()(const Key& key) const {
+    // FNV-1a style mixing of the key words
+    std::size_t h = 1469598103934665603ULL;
+    auto mix = [&h](unsigned long long word) {
+        h ^= word;
+        h *= 1099511628211ULL;
+    };
+    for (long long g : key.geometry) mix((unsigned long long)g);
+    for (double m : key.material) {
+        unsigned long long bits;
+        std::memcpy(&bits, &m, sizeof(bits));
+        mix(bits);
+    }
+    return h;
+}
+
+ElementKernel::Matrix8& ElementStiffnessCache::findOrInsert(const Key& key, bool& inserted) {
+    lookups++;
+    auto result = entries.try_emplace(key);
+    inserted = result.second;
+    if (!inserted) hits++;
+    return result.first->second;
+}
+
+void ElementStiffnessCache::clear() {
+    entries.clear();
+    resetStatistics();
+}
@@ -0,0 +1,59 @@
+#ifndef ELEMENT_CACHE_H
+#define ELEMENT_CACHE_H
+
+#include <array>
+#include <cstddef>
+#include <unordered_map>
+#include "element_kernel.h"
+
+// Cache of element stiffness matrices keyed on element shape and material.
+// Node coordinates are taken relative to the first node and quantized, so
+// translated copies of the same element share one Ke. Not thread-safe:
+// lookups happen serially, the (parallel) callers only read entries.
+class ElementStiffnessCache {
+public:
+    struct Key {
+        std::array<long long, 6> geometry;  // Quantized (x, y) of nodes 1..3 relative to node 0
+        std::array<double, 10> material;    // [D] entries and thickness
+        
+        bool operator==(const Key& other) const {
+            return geometry == other.geometry && material == other.material;
+        }
+    };
+    
+    struct Statistics {
+        long long lookups;
+        long long hits;
+        std::size_t entries;
+        
+        double hitRate() const { return lookups > 0 ? (double)hits / lookups : 0.0; }
+    };
+    
+    // quantum: coordinate resolution (m) below which geometries are treated as equal
+    explicit ElementStiffnessCache(double quantum = 1e-12);
+    
+    void setQuantum(double q) { quantum = q; clear(); }
+    
+    Key makeKey(const double x[4], const double y[4],
+                const ElementKernel::Matrix3& D, double t) const;
+    
+    // Entry for key; 'inserted' tells the caller the entry is new and must be filled.
+    // References stay valid until clear().
+    ElementKernel::Matrix8& findOrInsert(const Key& key, bool& inserted);
+    
+    void clear();
+    void resetStatistics() { lookups = 0; hits = 0; }
+    Statistics getStatistics() const { return {lookups, hits, entries.size()}; }
+    
+private:
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const;
+    };
+    
+    double quantum;
+    std::unordered_map<Key, ElementKernel::Matrix8, KeyHash> entries;
+    long long lookups;
+    long long hits;
+};
+
+#endif
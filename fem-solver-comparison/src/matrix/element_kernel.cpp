@@ -0,0 +1,241 @@
+#include "element_kernel.h"
+#include <cmath>
+
+const ElementKernel::GaussTable& ElementKernel::gaussTable() {
+    static const GaussTable table = []() {
+        GaussTable t;
+        double gp = 1.0 / std::sqrt(3.0);
+        double points[2] = {-gp, gp};
+        
+        // Same point ordering as StiffnessMatrix::gaussQuadrature2D (xi outer, eta inner)
+        int g = 0;
+        for (int i = 0; i < 2; i++) {
+            for (int j = 0; j < 2; j++, g++) {
+                double xi = points[i];
+                double eta = points[j];
+                
+                t.dN_dxi[g][0] = -0.25 * (1.0 - eta);
+                t.dN_dxi[g][1] =  0.25 * (1.0 - eta);
+                t.dN_dxi[g][2] =  0.25 * (1.0 + eta);
+                t.dN_dxi[g][3] = -0.25 * (1.0 + eta);
+                
+                t.dN_deta[g][0] = -0.25 * (1.0 - xi);
+                t.dN_deta[g][1] = -0.25 * (1.0 + xi);
+                t.dN_deta[g][2] =  0.25 * (1.0 + xi);
+                t.dN_deta[g][3] =  0.25 * (1.0 - xi);
+                
+                t.weight[g] = 1.0;
+            }
+        }
+        return t;
+    }();
+    return table;
+}
+
+ElementKernel::Matrix3 ElementKernel::constitutiveMatrix(double E, double nu) {
+    double factor = E / (1.0 - nu * nu);
+    
+    Matrix3 D = {};
+    D[0] = factor;
+    D[1] = factor * nu;
+    D[3] = factor * nu;
+    D[4] = factor;
+    D[8] = factor * (1.0 - nu) / 2.0;
+    return D;
+}
+
+double ElementKernel::physicalGradients(const double dN_dxi[NUM_NODES], const double dN_deta[NUM_NODES],
+                                        const double x[NUM_NODES], const double y[NUM_NODES],
+                                        double dN_dx[NUM_NODES], double dN_dy[NUM_NODES]) {
+    // Jacobian, computed once per point
+    double J00 = 0.0, J01 = 0.0, J10 = 0.0, J11 = 0.0;
+    for (int i = 0; i < NUM_NODES; i++) {
+        J00 += dN_dxi[i] * x[i];
+        J01 += dN_dxi[i] * y[i];
+        J10 += dN_deta[i] * x[i];
+        J11 += dN_deta[i] * y[i];
+    }
+    
+    double detJ = J00 * J11 - J01 * J10;
+    double invDet = 1.0 / detJ;
+    
+    for (int i = 0; i < NUM_NODES; i++) {
+        dN_dx[i] = ( J11 * dN_dxi[i] - J01 * dN_deta[i]) * invDet;
+        dN_dy[i] = (-J10 * dN_dxi[i] + J00 * dN_deta[i]) * invDet;
+    }
+    
+    return detJ;
+}
+
+void ElementKernel::computeStiffness(const double x[NUM_NODES], const double y[NUM_NODES],
+                                     const Matrix3& D, double t, Matrix8& Ke) {
+    const GaussTable& table = gaussTable();
+    Ke.fill(0.0);
+    
+    for (int g = 0; g < NUM_GAUSS; g++) {
+        double dN_dx[NUM_NODES], dN_dy[NUM_NODES];
+        double detJ = physicalGradients(table.dN_dxi[g], table.dN_deta[g], x, y, dN_dx, dN_dy);
+        double scale = detJ * table.weight[g] * t;
+        
+        // Fused B^T D B: B has only two non-zeros per column, so [D][B] for
+        // node b is formed from (dN_dx[b], dN_dy[b]) and contracted directly
+        for (int b = 0; b < NUM_NODES; b++) {
+            double bx = dN_dx[b] * scale;
+            double by = dN_dy[b] * scale;
+            
+            double DBu0 = D[0] * bx + D[2] * by;
+            double DBu1 = D[3] * bx + D[5] * by;
+            double DBu2 = D[6] * bx + D[8] * by;
+            double DBv0 = D[1] * by + D[2] * bx;
+            double DBv1 = D[4] * by + D[5] * bx;
+            double DBv2 = D[7] * by + D[8] * bx;
+            
+            for (int a = 0; a < NUM_NODES; a++) {
+                double ax = dN_dx[a];
+                double ay = dN_dy[a];
+                double* rowU = &Ke[(2 * a) * NUM_DOF + 2 * b];
+                double* rowV = &Ke[(2 * a + 1) * NUM_DOF + 2 * b];
+                
+                rowU[0] += ax * DBu0 + ay * DBu2;
+                rowU[1] += ax * DBv0 + ay * DBv2;
+                rowV[0] += ay * DBu1 + ax * DBu2;
+                rowV[1] += ay * DBv1 + ax * DBv2;
+            }
+        }
+    }
+}
+
+double ElementKernel::computeBMatrix(double xi, double eta,
+                                     const double x[NUM_NODES], const double y[NUM_NODES],
+                                     BMatrix& B) {
+    double dN_dxi[NUM_NODES] = {
+        -0.25 * (1.0 - eta), 0.25 * (1.0 - eta), 0.25 * (1.0 + eta), -0.25 * (1.0 + eta)
+    };
+    double dN_deta[NUM_NODES] = {
+        -0.25 * (1.0 - xi), -0.25 * (1.0 + xi), 0.25 * (1.0 + xi), 0.25 * (1.0 - xi)
+    };
+    
+    double dN_dx[NUM_NODES], dN_dy[NUM_NODES];
+    double detJ = physicalGradients(dN_dxi, dN_deta, x, y, dN_dx, dN_dy);
+    
+    for (int i = 0; i < NUM_NODES; i++) {
+        B[0 * NUM_DOF + 2*i]     = dN_dx[i];
+        B[0 * NUM_DOF + 2*i + 1] = 0.0;
+        B[1 * NUM_DOF + 2*i]     = 0.0;
+        B[1 * NUM_DOF + 2*i + 1] = dN_dy[i];
+        B[2 * NUM_DOF + 2*i]     = dN_dy[i];
+        B[2 * NUM_DOF + 2*i + 1] = dN_dx[i];
+    }
+    
+    return detJ;
+}
+
+void ElementKernel::computeStiffnessBatch(const ElementBatch& batch, const Matrix3& D, double t,
+                                          StiffnessBatch& out) {
+    const GaussTable& table = gaussTable();
+    
+    SimdVec zero = SimdVec::broadcast(0.0);
+    for (int k = 0; k < NUM_DOF * NUM_DOF; k++) zero.store(out.Ke[k]);
+    
+    SimdVec x[NUM_NODES], y[NUM_NODES];
+    for (int i = 0; i < NUM_NODES; i++) {
+        x[i] = SimdVec::load(batch.x[i]);
+        y[i] = SimdVec::load(batch.y[i]);
+    }
+    
+    SimdVec d[9];
+    for (int k = 0; k < 9; k++) d[k] = SimdVec::broadcast(D[k]);
+    
+    for (int g = 0; g < NUM_GAUSS; g++) {
+        // Jacobian for all lanes
+        SimdVec J00 = zero, J01 = zero, J10 = zero, J11 = zero;
+        for (int i = 0; i < NUM_NODES; i++) {
+            SimdVec dxi = SimdVec::broadcast(table.dN_dxi[g][i]);
+            SimdVec deta = SimdVec::broadcast(table.dN_deta[g][i]);
+            J00 = SimdVec::fmadd(dxi, x[i], J00);
+            J01 = SimdVec::fmadd(dxi, y[i], J01);
+            J10 = SimdVec::fmadd(deta, x[i], J10);
+            J11 = SimdVec::fmadd(deta, y[i], J11);
+        }
+        
+        SimdVec detJ = J00 * J11 - J01 * J10;
+        SimdVec invDet = SimdVec::broadcast(1.0) / detJ;
+        SimdVec scale = detJ * SimdVec::broadcast(table.weight[g] * t);
+        
+        SimdVec dN_dx[NUM_NODES], dN_dy[NUM_NODES];
+        for (int i = 0; i < NUM_NODES; i++) {
+            SimdVec dxi = SimdVec::broadcast(table.dN_dxi[g][i]);
+            SimdVec deta = SimdVec::broadcast(table.dN_deta[g][i]);
+            dN_dx[i] = (J11 * dxi - J01 * deta) * invDet;
+            dN_dy[i] = (J00 * deta - J10 * dxi) * invDet;
+        }
+        
+        // Fused B^T D B, as in computeStiffness
+        for (int b = 0; b < NUM_NODES; b++) {
+            SimdVec bx = dN_dx[b] * scale;
+            SimdVec by = dN_dy[b] * scale;
+            
+            SimdVec DBu0 = SimdVec::fmadd(d[0], bx, d[2] * by);
+            SimdVec DBu1 = SimdVec::fmadd(d[3], bx, d[5] * by);
+            SimdVec DBu2 = SimdVec::fmadd(d[6], bx, d[8] * by);
+            SimdVec DBv0 = SimdVec::fmadd(d[1], by, d[2] * bx);
+            SimdVec DBv1 = SimdVec::fmadd(d[4], by, d[5] * bx);
+            SimdVec DBv2 = SimdVec::fmadd(d[7], by, d[8] * bx);
+            
+            for (int a = 0; a < NUM_NODES; a++) {
+                SimdVec ax = dN_dx[a];
+                SimdVec ay = dN_dy[a];
+                double* uu = out.Ke[(2 * a) * NUM_DOF + 2 * b];
+                double* uv = out.Ke[(2 * a) * NUM_DOF + 2 * b + 1];
+                double* vu = out.Ke[(2 * a + 1) * NUM_DOF + 2 * b];
+                double* vv = out.Ke[(2 * a + 1) * NUM_DOF + 2 * b + 1];
+                
+                SimdVec::fmadd(ax, DBu0, SimdVec::fmadd(ay, DBu2, SimdVec::load(uu))).store(uu);
+                SimdVec::fmadd(ax, DBv0, SimdVec::fmadd(ay, DBv2, SimdVec::load(uv))).store(uv);
+                SimdVec::fmadd(ay, DBu1, SimdVec::fmadd(ax, DBu2, SimdVec::load(vu))).store(vu);
+                SimdVec::fmadd(ay, DBv1, SimdVec::fmadd(ax, DBv2, SimdVec::load(vv))).store(vv);
+            }
+        }
+    }
+}
+
+void ElementKernel::computeCentreStrainBatch(const ElementBatch& batch, const double Ue[NUM_DOF][BATCH],
+                                             double strain[3][BATCH]) {
+    // Natural derivatives at xi = eta = 0
+    const double dN_dxi[NUM_NODES] = {-0.25, 0.25, 0.25, -0.25};
+    const double dN_deta[NUM_NODES] = {-0.25, -0.25, 0.25, 0.25};
+    
+    SimdVec zero = SimdVec::broadcast(0.0);
+    SimdVec J00 = zero, J01 = zero, J10 = zero, J11 = zero;
+    for (int i = 0; i < NUM_NODES; i++) {
+        SimdVec x = SimdVec::load(batch.x[i]);
+        SimdVec y = SimdVec::load(batch.y[i]);
+        SimdVec dxi = SimdVec::broadcast(dN_dxi[i]);
+        SimdVec deta = SimdVec::broadcast(dN_deta[i]);
+        J00 = SimdVec::fmadd(dxi, x, J00);
+        J01 = SimdVec::fmadd(dxi, y, J01);
+        J10 = SimdVec::fmadd(deta, x, J10);
+        J11 = SimdVec::fmadd(deta, y, J11);
+    }
+    
+    SimdVec invDet = SimdVec::broadcast(1.0) / (J00 * J11 - J01 * J10);
+    
+    // {strain} = [B]{Ue}: ex = sum dN_dx u, ey = sum dN_dy v, gxy = sum dN_dy u + dN_dx v
+    SimdVec ex = zero, ey = zero, gxy = zero;
+    for (int i = 0; i < NUM_NODES; i++) {
+        SimdVec dxi = SimdVec::broadcast(dN_dxi[i]);
+        SimdVec deta = SimdVec::broadcast(dN_deta[i]);
+        SimdVec dN_dx = (J11 * dxi - J01 * deta) * invDet;
+        SimdVec dN_dy = (J00 * deta - J10 * dxi) * invDet;
+        SimdVec u = SimdVec::load(Ue[2 * i]);
+        SimdVec v = SimdVec::load(Ue[2 * i + 1]);
+        
+        ex = SimdVec::fmadd(dN_dx, u, ex);
+        ey = SimdVec::fmadd(dN_dy, v, ey);
+        gxy = SimdVec::fmadd(dN_dy, u, SimdVec::fmadd(dN_dx, v, gxy));
+    }
+    
+    ex.store(strain[0]);
+    ey.store(strain[1]);
+    gxy.store(strain[2]);
+}
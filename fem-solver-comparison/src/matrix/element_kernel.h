@@ -0,0 +1,68 @@
+#ifndef ELEMENT_KERNEL_H
+#define ELEMENT_KERNEL_H
+
+#include <array>
+#include "simd_vec.h"
+
+// Fixed-size, allocation-free kernels for the 4-node plane stress quad.
+// Matrices are stored row-major in std::array with compile-time sizes.
+class ElementKernel {
+public:
+    static constexpr int NUM_NODES = 4;
+    static constexpr int NUM_DOF = 8;
+    static constexpr int NUM_GAUSS = 4;  // 2x2 rule
+    static constexpr int BATCH = SIMD_WIDTH;  // Elements per batched kernel call
+    
+    using Matrix3 = std::array<double, 3 * 3>;             // [D]
+    using BMatrix = std::array<double, 3 * NUM_DOF>;       // [B], 3x8
+    using Matrix8 = std::array<double, NUM_DOF * NUM_DOF>; // [Ke], 8x8
+    
+    // Node coordinates of BATCH elements in structure-of-arrays lanes
+    struct ElementBatch {
+        alignas(64) double x[NUM_NODES][BATCH];
+        alignas(64) double y[NUM_NODES][BATCH];
+    };
+    
+    // Ke of BATCH elements: entry (m, n) of lane l is Ke[m * 8 + n][l]
+    struct StiffnessBatch {
+        alignas(64) double Ke[NUM_DOF * NUM_DOF][BATCH];
+    };
+    
+    // Shape function derivatives at the 2x2 Gauss points (built once)
+    struct GaussTable {
+        double dN_dxi[NUM_GAUSS][NUM_NODES];
+        double dN_deta[NUM_GAUSS][NUM_NODES];
+        double weight[NUM_GAUSS];
+    };
+    
+    static const GaussTable& gaussTable();
+    
+    // Plane stress constitutive matrix
+    static Matrix3 constitutiveMatrix(double E, double nu);
+    
+    // Element stiffness [Ke] = sum_gp t * w * detJ * [B]^T [D] [B]
+    static void computeStiffness(const double x[NUM_NODES], const double y[NUM_NODES],
+                                 const Matrix3& D, double t, Matrix8& Ke);
+    
+    // Batched element stiffness, one element per SIMD lane
+    static void computeStiffnessBatch(const ElementBatch& batch, const Matrix3& D, double t,
+                                      StiffnessBatch& out);
+    
+    // Batched strain {ex, ey, gxy} at the element centre from element displacements
+    // Ue[8][BATCH]; strain[3][BATCH]
+    static void computeCentreStrainBatch(const ElementBatch& batch, const double Ue[NUM_DOF][BATCH],
+                                         double strain[3][BATCH]);
+    
+    // Strain-displacement matrix [B] at (xi, eta); returns det(J)
+    static double computeBMatrix(double xi, double eta,
+                                 const double x[NUM_NODES], const double y[NUM_NODES],
+                                 BMatrix& B);
+    
+private:
+    // Physical shape function gradients from natural ones; returns det(J)
+    static double physicalGradients(const double dN_dxi[NUM_NODES], const double dN_deta[NUM_NODES],
+                                    const double x[NUM_NODES], const double y[NUM_NODES],
+                                    double dN_dx[NUM_NODES], double dN_dy[NUM_NODES]);
+};
+
+#endif
@@ -0,0 +1,62 @@
+#include "matrix_free_operator.h"
+#include <algorithm>
+
+MatrixFreeStiffnessOperator::MatrixFreeStiffnessOperator(StiffnessMatrix& mesh,
+                                                         const std::vector<int>& fixedDOFs,
+                                                         int numThreads)
+    : mesh(mesh), fixedDOFs(fixedDOFs), isFixed(mesh.getNumDOF(), 0), numThreads(numThreads) {
+    for (int dof : fixedDOFs) isFixed[dof] = 1;
+    
+    // Element matrices come from the Ke cache (one matrix on a uniform grid)
+    mesh.resolveElementStiffness(numThreads);
+}
+
+void MatrixFreeStiffnessOperator::apply(const std::vector<double>& x, std::vector<double>& y) const {
+    std::fill(y.begin(), y.end(), 0.0);
+    
+    const auto& elements = mesh.getElements();
+    
+    // Same coloring as assembly: elements of a color scatter to disjoint DOFs
+    for (const auto& color : mesh.getElementColors()) {
+        #pragma omp parallel for num_threads(numThreads) schedule(static)
+        for (int k = 0; k < (int)color.size(); k++) {
+            int e = color[k];
+            ElementKernel::Matrix8 scratch;
+            const ElementKernel::Matrix8& Ke = mesh.elementStiffness(e, scratch);
+            const auto& elem = elements[e];
+            
+            // Gather element DOFs, with constrained columns zeroed
+            int dofs[8];
+            double xe[8];
+            for (int i = 0; i < 4; i++) {
+                dofs[2*i]     = 2 * elem.nodes[i];
+                dofs[2*i + 1] = 2 * elem.nodes[i] + 1;
+            }
+            for (int m = 0; m < 8; m++) {
+                xe[m] = isFixed[dofs[m]] ? 0.0 : x[dofs[m]];
+            }
+            
+            for (int m = 0; m < 8; m++) {
+                double sum = 0.0;
+                for (int n = 0; n < 8; n++) {
+                    sum += Ke[m * 8 + n] * xe[n];
+                }
+                y[dofs[m]] += sum;
+            }
+        }
+    }
+    
+    // Constrained rows are identity rows
+    for (int dof : fixedDOFs) {
+        y[dof] = x[dof];
+    }
+}
+
+double MatrixFreeStiffnessOperator::memoryBytes() const {
+    // Only the cached element matrices, the per-element pointers into them and the DOF mask are stored
+    auto stats = mesh.getElementCacheStatistics();
+    double elementTable = mesh.hasResolvedElementStiffness()
+                          ? (double)mesh.getNumElements() * sizeof(const ElementKernel::Matrix8*) : 0.0;
+    return (double)stats.entries * sizeof(ElementKernel::Matrix8) + elementTable +
+           isFixed.size() * sizeof(char) + fixedDOFs.size() * sizeof(int);
+}
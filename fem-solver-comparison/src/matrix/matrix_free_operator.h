@@ -0,0 +1,29 @@
+#ifndef MATRIX_FREE_OPERATOR_H
+#define MATRIX_FREE_OPERATOR_H
+
+#include <vector>
+#include <string>
+#include "stiffness_matrix.h"
+#include "../solvers/linear_operator.h"
+
+// y = K * x computed element by element from the mesh, without assembling K.
+// Dirichlet DOFs are masked exactly like BoundaryConditions::applyFixedBoundary
+// (identity rows, zero columns), so CG sees the same constrained system.
+class MatrixFreeStiffnessOperator : public LinearOperator {
+public:
+    MatrixFreeStiffnessOperator(StiffnessMatrix& mesh, const std::vector<int>& fixedDOFs,
+                                int numThreads = 1);
+    
+    int size() const override { return mesh.getNumDOF(); }
+    void apply(const std::vector<double>& x, std::vector<double>& y) const override;
+    double memoryBytes() const override;
+    std::string getName() const override { return "Matrix-free"; }
+    
+private:
+    StiffnessMatrix& mesh;
+    std::vector<int> fixedDOFs;
+    std::vector<char> isFixed;
+    int numThreads;
+};
+
+#endif
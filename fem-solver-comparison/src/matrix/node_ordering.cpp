@@ -0,0 +1,235 @@
+#include "node_ordering.h"
+#include <algorithm>
+
+NodeOrdering::Graph NodeOrdering::nodalGraph(const std::vector<StiffnessMatrix::Element>& elements,
+                                             int numNodes) {
+    Graph graph(numNodes);
+    for (const auto& elem : elements) {
+        for (int a = 0; a < 4; a++) {
+            for (int b = 0; b < 4; b++) {
+                if (a != b) graph[elem.nodes[a]].push_back(elem.nodes[b]);
+            }
+        }
+    }
+    
+    for (auto& neighbours : graph) {
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+    }
+    return graph;
+}
+
+NodeOrdering::Graph NodeOrdering::matrixGraph(const CSRMatrix& A) {
+    Graph graph(A.n);
+    for (int i = 0; i < A.n; i++) {
+        for (int k = A.rowPointers[i]; k < A.rowPointers[i + 1]; k++) {
+            if (A.colIndices[k] != i) graph[i].push_back(A.colIndices[k]);
+        }
+        std::sort(graph[i].begin(), graph[i].end());
+    }
+    return graph;
+}
+
+int NodeOrdering::levelStructure(const Graph& graph, const std::vector<int>& roots,
+                                 std::vector<int>& level, std::vector<int>& visitOrder, int& width) {
+    level.assign(graph.size(), -1);
+    visitOrder.clear();
+    
+    for (int root : roots) {
+        level[root] = 0;
+        visitOrder.push_back(root);
+    }
+    
+    int depth = 1;
+    width = roots.size();
+    size_t levelStart = 0;
+    for (size_t k = 0; k < visitOrder.size(); k++) {
+        int p = visitOrder[k];
+        if (level[p] == depth) {
+            // First node of a new level
+            width = std::max(width, (int)(k - levelStart));
+            levelStart = k;
+            depth++;
+        }
+        for (int q : graph[p]) {
+            if (level[q] < 0) {
+                level[q] = level[p] + 1;
+                visitOrder.push_back(q);
+            }
+        }
+    }
+    width = std::max(width, (int)(visitOrder.size() - levelStart));
+    return depth;
+}
+
+std::vector<int> NodeOrdering::startingLevel(const Graph& graph, int start) {
+    std::vector<int> level, visitOrder, candidateLevel, candidateOrder;
+    int width, candidateWidth;
+    int root = start;
+    int depth = levelStructure(graph, {root}, level, visitOrder, width);
+    
+    // George-Liu: restart from the lowest-degree node of the deepest level
+    // while that increases the eccentricity
+    while (true) {
+        int candidate = -1;
+        for (int p : visitOrder) {
+            if (level[p] != depth - 1) continue;
+            if (candidate < 0 || graph[p].size() < graph[candidate].size()) candidate = p;
+        }
+        
+        int candidateDepth = levelStructure(graph, {candidate}, candidateLevel, candidateOrder,
+                                            candidateWidth);
+        if (candidateDepth <= depth) break;
+        
+        root = candidate;
+        depth = candidateDepth;
+        width = candidateWidth;
+        level.swap(candidateLevel);
+        visitOrder.swap(candidateOrder);
+    }
+    
+    // The deepest level as a whole, in visit order
+    std::vector<int> deepest;
+    for (int p : visitOrder) {
+        if (level[p] == depth - 1) deepest.push_back(p);
+    }
+    levelStructure(graph, deepest, candidateLevel, candidateOrder, candidateWidth);
+    
+    if (candidateWidth < width) return deepest;
+    return {root};
+}
+
+std::vector<int> NodeOrdering::reverseCuthillMcKee(const Graph& graph) {
+    int n = graph.size();
+    std::vector<int> order;
+    order.reserve(n);
+    std::vector<bool> numbered(n, false);
+    
+    // Components are taken in order of their lowest-degree unnumbered node
+    std::vector<int> byDegree(n);
+    for (int p = 0; p < n; p++) byDegree[p] = p;
+    std::stable_sort(byDegree.begin(), byDegree.end(),
+                     [&graph](int a, int b) { return graph[a].size() < graph[b].size(); });
+    
+    std::vector<int> neighbours;
+    for (int start : byDegree) {
+        if (numbered[start]) continue;
+        
+        size_t head = order.size();
+        for (int p : startingLevel(graph, start)) {
+            order.push_back(p);
+            numbered[p] = true;
+        }
+        
+        // Cuthill-McKee: number unvisited neighbours by increasing degree
+        for (; head < order.size(); head++) {
+            neighbours.clear();
+            for (int q : graph[order[head]]) {
+                if (!numbered[q]) neighbours.push_back(q);
+            }
+            std::stable_sort(neighbours.begin(), neighbours.end(),
+                             [&graph](int a, int b) { return graph[a].size() < graph[b].size(); });
+            for (int q : neighbours) {
+                numbered[q] = true;
+                order.push_back(q);
+            }
+        }
+    }
+    
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+std::vector<int> NodeOrdering::nestedDissection(const Graph& graph, int leafSize) {
+    int n = graph.size();
+    std::vector<int> order;
+    order.reserve(n);
+    std::vector<int> localId(n, -1);
+    
+    std::vector<int> all(n);
+    for (int p = 0; p < n; p++) all[p] = p;
+    dissect(graph, all, leafSize, localId, order);
+    return order;
+}
+
+void NodeOrdering::dissect(const Graph& graph, const std::vector<int>& part, int leafSize,
+                           std::vector<int>& localId, std::vector<int>& order) {
+    int size = part.size();
+    if (size <= leafSize) {
+        order.insert(order.end(), part.begin(), part.end());
+        return;
+    }
+    
+    // Induced subgraph on part
+    for (int k = 0; k < size; k++) localId[part[k]] = k;
+    Graph sub(size);
+    for (int k = 0; k < size; k++) {
+        for (int q : graph[part[k]]) {
+            if (localId[q] >= 0) sub[k].push_back(localId[q]);
+        }
+    }
+    for (int k = 0; k < size; k++) localId[part[k]] = -1;
+    
+    // Disconnected parts (e.g. constrained DOFs) need no separator
+    std::vector<int> component(size, -1);
+    std::vector<std::vector<int>> components;
+    for (int k = 0; k < size; k++) {
+        if (component[k] >= 0) continue;
+        int c = components.size();
+        components.push_back({k});
+        component[k] = c;
+        for (size_t h = 0; h < components[c].size(); h++) {
+            for (int q : sub[components[c][h]]) {
+                if (component[q] < 0) {
+                    component[q] = c;
+                    components[c].push_back(q);
+                }
+            }
+        }
+    }
+    if (components.size() > 1) {
+        for (auto& members : components) {
+            std::sort(members.begin(), members.end());
+            for (int& k : members) k = part[k];
+            dissect(graph, members, leafSize, localId, order);
+        }
+        return;
+    }
+    
+    std::vector<int> level, visitOrder;
+    int width;
+    int depth = levelStructure(sub, startingLevel(sub, 0), level, visitOrder, width);
+    if (depth < 3) {
+        order.insert(order.end(), part.begin(), part.end());
+        return;
+    }
+    
+    // Separator: the level holding the median vertex, kept off the ends
+    int middle = std::min(std::max(level[visitOrder[size / 2]], 1), depth - 2);
+    std::vector<int> first, second, separator;
+    for (int k = 0; k < size; k++) {
+        if (level[k] < middle) first.push_back(part[k]);
+        else if (level[k] > middle) second.push_back(part[k]);
+        else separator.push_back(part[k]);
+    }
+    
+    dissect(graph, first, leafSize, localId, order);
+    dissect(graph, second, leafSize, localId, order);
+    order.insert(order.end(), separator.begin(), separator.end());
+}
+
+NodeOrdering::Envelope NodeOrdering::envelope(const Graph& graph) {
+    Envelope env = {0, 0};
+    int n = graph.size();
+    
+    for (int p = 0; p < n; p++) {
+        int first = p;
+        if (!graph[p].empty()) first = std::min(first, graph[p].front());
+        
+        // Rows 2p and 2p+1 both start at column 2 * first
+        int width = 2 * (p - first);
+        env.bandwidth = std::max(env.bandwidth, width + 1);
+        env.profile += 2LL * width + 1;
+    }
+    return env;
+}
@@ -0,0 +1,53 @@
+#ifndef NODE_ORDERING_H
+#define NODE_ORDERING_H
+
+#include <vector>
+#include "stiffness_matrix.h"
+
+// Graph orderings on the nodal adjacency graph of the mesh. Orderings are
+// returned as lists of old node IDs in their new order (order[newId] = oldId).
+class NodeOrdering {
+public:
+    // Sorted neighbour lists without self loops
+    using Graph = std::vector<std::vector<int>>;
+    
+    // Envelope of K at DOF level (2 DOF per node, lower triangle)
+    struct Envelope {
+        int bandwidth;       // max i - j over nonzeros K[i][j], j <= i
+        long long profile;   // sum over rows of i - (first column of row i)
+    };
+    
+    // Nodes are adjacent when they share an element
+    static Graph nodalGraph(const std::vector<StiffnessMatrix::Element>& elements, int numNodes);
+    
+    // Adjacency graph of a (structurally symmetric) CSR matrix
+    static Graph matrixGraph(const CSRMatrix& A);
+    
+    // Reverse Cuthill-McKee, started from a pseudo-peripheral node of every component
+    static std::vector<int> reverseCuthillMcKee(const Graph& graph);
+    
+    // Nested dissection with level-set separators: each part is split by the
+    // middle level of a breadth-first level structure, parts are numbered before
+    // their separator; parts of at most leafSize vertices keep their order
+    static std::vector<int> nestedDissection(const Graph& graph, int leafSize = 64);
+    
+    // Envelope of K in the current numbering
+    static Envelope envelope(const Graph& graph);
+    
+private:
+    // Breadth-first level structure from a set of roots (level 0); returns the number of
+    // levels and the size of the largest level in width
+    static int levelStructure(const Graph& graph, const std::vector<int>& roots,
+                              std::vector<int>& level, std::vector<int>& visitOrder, int& width);
+    
+    // Starting level for Cuthill-McKee in the component of start: a pseudo-peripheral
+    // node (George-Liu), or the whole deepest level of its level structure when that
+    // gives narrower levels (on a plate: sweep the long side starting from a short edge)
+    static std::vector<int> startingLevel(const Graph& graph, int start);
+    
+    // Recursive step of nestedDissection on the vertex subset part (sorted)
+    static void dissect(const Graph& graph, const std::vector<int>& part, int leafSize,
+                        std::vector<int>& localId, std::vector<int>& order);
+};
+
+#endif
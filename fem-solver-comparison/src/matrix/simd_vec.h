@@ -0,0 +1,84 @@
+#ifndef SIMD_VEC_H
+#define SIMD_VEC_H
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Minimal packed-double vector used by the batched element kernels.
+// Width follows the target ISA: 8 lanes with AVX-512, 4 with AVX2,
+// and a single scalar lane otherwise.
+#if defined(__AVX512F__)
+
+constexpr int SIMD_WIDTH = 8;
+
+struct SimdVec {
+    __m512d v;
+    
+    static SimdVec load(const double* p) { return {_mm512_loadu_pd(p)}; }
+    static SimdVec broadcast(double s) { return {_mm512_set1_pd(s)}; }
+    // Lanes base[idx[0]], ..., base[idx[7]]
+    static SimdVec gather(const double* base, const int* idx) {
+        return {_mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF,
+                                         _mm256_loadu_si256((const __m256i*)idx), base, 8)};
+    }
+    void store(double* p) const { _mm512_storeu_pd(p, v); }
+    
+    friend SimdVec operator+(SimdVec a, SimdVec b) { return {_mm512_add_pd(a.v, b.v)}; }
+    friend SimdVec operator-(SimdVec a, SimdVec b) { return {_mm512_sub_pd(a.v, b.v)}; }
+    friend SimdVec operator*(SimdVec a, SimdVec b) { return {_mm512_mul_pd(a.v, b.v)}; }
+    friend SimdVec operator/(SimdVec a, SimdVec b) { return {_mm512_div_pd(a.v, b.v)}; }
+    
+    // a * b + c
+    static SimdVec fmadd(SimdVec a, SimdVec b, SimdVec c) { return {_mm512_fmadd_pd(a.v, b.v, c.v)}; }
+};
+
+#elif defined(__AVX2__)
+
+constexpr int SIMD_WIDTH = 4;
+
+struct SimdVec {
+    __m256d v;
+    
+    static SimdVec load(const double* p) { return {_mm256_loadu_pd(p)}; }
+    static SimdVec broadcast(double s) { return {_mm256_set1_pd(s)}; }
+    static SimdVec gather(const double* base, const int* idx) {
+        return {_mm256_i32gather_pd(base, _mm_loadu_si128((const __m128i*)idx), 8)};
+    }
+    void store(double* p) const { _mm256_storeu_pd(p, v); }
+    
+    friend SimdVec operator+(SimdVec a, SimdVec b) { return {_mm256_add_pd(a.v, b.v)}; }
+    friend SimdVec operator-(SimdVec a, SimdVec b) { return {_mm256_sub_pd(a.v, b.v)}; }
+    friend SimdVec operator*(SimdVec a, SimdVec b) { return {_mm256_mul_pd(a.v, b.v)}; }
+    friend SimdVec operator/(SimdVec a, SimdVec b) { return {_mm256_div_pd(a.v, b.v)}; }
+    
+#if defined(__FMA__)
+    static SimdVec fmadd(SimdVec a, SimdVec b, SimdVec c) { return {_mm256_fmadd_pd(a.v, b.v, c.v)}; }
+#else
+    static SimdVec fmadd(SimdVec a, SimdVec b, SimdVec c) { return a * b + c; }
+#endif
+};
+
+#else
+
+constexpr int SIMD_WIDTH = 1;
+
+struct SimdVec {
+    double v;
+    
+    static SimdVec load(const double* p) { return {*p}; }
+    static SimdVec broadcast(double s) { return {s}; }
+    static SimdVec gather(const double* base, const int* idx) { return {base[*idx]}; }
+    void store(double* p) const { *p = v; }
+    
+    friend SimdVec operator+(SimdVec a, SimdVec b) { return {a.v + b.v}; }
+    friend SimdVec operator-(SimdVec a, SimdVec b) { return {a.v - b.v}; }
+    friend SimdVec operator*(SimdVec a, SimdVec b) { return {a.v * b.v}; }
+    friend SimdVec operator/(SimdVec a, SimdVec b) { return {a.v / b.v}; }
+    
+    static SimdVec fmadd(SimdVec a, SimdVec b, SimdVec c) { return {a.v * b.v + c.v}; }
+};
+
+#endif
+
+#endif
@@ -0,0 +1,204 @@
+#include "stencil_operator.h"
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+StencilOperator::StencilOperator(StiffnessMatrix& mesh, const std::vector<int>& fixedDOFs,
+                                 int numThreads)
+    : nx(mesh.getNx()), ny(mesh.getNy()), numThreads(numThreads) {
+    // Lattice position of every node; the permutation is kept only if it is not the identity
+    int numNodes = (nx + 1) * (ny + 1);
+    std::vector<int> nodeToLattice(numNodes);
+    bool identity = true;
+    latticeToNode.resize(numNodes);
+    for (int j = 0; j <= ny; j++) {
+        for (int i = 0; i <= nx; i++) {
+            int p = j * (nx + 1) + i;
+            latticeToNode[p] = mesh.latticeNode(i, j);
+            nodeToLattice[latticeToNode[p]] = p;
+            if (latticeToNode[p] != p) identity = false;
+        }
+    }
+    
+    for (int d : fixedDOFs) this->fixedDOFs.push_back(2 * nodeToLattice[d / 2] + d % 2);
+    
+    if (identity) {
+        latticeToNode.clear();
+    } else {
+        xLattice.resize(2 * numNodes);
+        yLattice.resize(2 * numNodes);
+    }
+    
+    // The stencil is only K if every element has the same Ke; a perturbed mesh
+    // can differ anywhere, so each element is checked against element 0
+    ElementKernel::Matrix8 Ke, KeOther;
+    mesh.computeElementStiffness(0, Ke);
+    
+    double maxEntry = 0.0;
+    for (int k = 0; k < 64; k++) maxEntry = std::max(maxEntry, std::abs(Ke[k]));
+    
+    for (int e = 1; e < mesh.getNumElements(); e++) {
+        mesh.computeElementStiffness(e, KeOther);
+        for (int k = 0; k < 64; k++) {
+            if (std::abs(Ke[k] - KeOther[k]) > 1e-10 * maxEntry) {
+                throw std::invalid_argument("StencilOperator requires a uniform grid (element " +
+                                            std::to_string(e) + " differs from element 0)");
+            }
+        }
+    }
+    
+    // Lattice offset of each local element node (counter-clockwise from bottom-left)
+    const int corner[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+    
+    for (int cls = 0; cls < NUM_CLASSES; cls++) {
+        int cx = cls % 3;
+        int cy = cls / 3;
+        
+        for (int off = 0; off < NUM_OFFSETS; off++) {
+            for (int k = 0; k < 4; k++) coeff[cls][off][k] = 0.0;
+        }
+        
+        // Sum the contributions of each of the four surrounding elements that exists
+        for (int a = 0; a < 4; a++) {
+            // The node is local node a of the element whose origin is (-corner[a]) away
+            int ex = -corner[a][0];
+            int ey = -corner[a][1];
+            bool existsX = (ex == -1) ? (cx != 0) : (cx != 2);
+            bool existsY = (ey == -1) ? (cy != 0) : (cy != 2);
+            if (!existsX || !existsY) continue;
+            
+            for (int b = 0; b < 4; b++) {
+                int off = offsetIndex(corner[b][0] - corner[a][0], corner[b][1] - corner[a][1]);
+                for (int r = 0; r < 2; r++) {
+                    for (int c = 0; c < 2; c++) {
+                        coeff[cls][off][r * 2 + c] += Ke[(2 * a + r) * 8 + 2 * b + c];
+                    }
+                }
+            }
+        }
+    }
+}
+
+void StencilOperator::applyNode(int i, int j, const std::vector<double>& x,
+                                std::vector<double>& y) const {
+    int cls = nodeClass(i, j);
+    double yu = 0.0, yv = 0.0;
+    
+    for (int dj = -1; dj <= 1; dj++) {
+        int qj = j + dj;
+        if (qj < 0 || qj > ny) continue;
+        for (int di = -1; di <= 1; di++) {
+            int qi = i + di;
+            if (qi < 0 || qi > nx) continue;
+            
+            const double* c = coeff[cls][offsetIndex(di, dj)];
+            int q = qj * (nx + 1) + qi;
+            yu += c[0] * x[2 * q] + c[1] * x[2 * q + 1];
+            yv += c[2] * x[2 * q] + c[3] * x[2 * q + 1];
+        }
+    }
+    
+    int p = j * (nx + 1) + i;
+    y[2 * p] = yu;
+    y[2 * p + 1] = yv;
+}
+
+void StencilOperator::apply(const std::vector<double>& x, std::vector<double>& y) const {
+    if (latticeToNode.empty()) {
+        applyLattice(x, y);
+        return;
+    }
+    
+    int numNodes = latticeToNode.size();
+    for (int p = 0; p < numNodes; p++) {
+        xLattice[2 * p] = x[2 * latticeToNode[p]];
+        xLattice[2 * p + 1] = x[2 * latticeToNode[p] + 1];
+    }
+    
+    applyLattice(xLattice, yLattice);
+    
+    for (int p = 0; p < numNodes; p++) {
+        y[2 * latticeToNode[p]] = yLattice[2 * p];
+        y[2 * latticeToNode[p] + 1] = yLattice[2 * p + 1];
+    }
+}
+
+void StencilOperator::applyLattice(const std::vector<double>& x, std::vector<double>& y) const {
+    const int stride = nx + 1;
+    
+    // Interior coefficients and neighbour offsets in locals so the sweep
+    // vectorizes without aliasing concerns
+    double c[NUM_OFFSETS][4];
+    int nodeOffset[NUM_OFFSETS];
+    for (int dj = -1; dj <= 1; dj++) {
+        for (int di = -1; di <= 1; di++) {
+            int off = offsetIndex(di, dj);
+            nodeOffset[off] = dj * stride + di;
+            for (int k = 0; k < 4; k++) c[off][k] = coeff[4][off][k];
+        }
+    }
+    
+    const double* xr = x.data();
+    double* yr = y.data();
+    
+    #pragma omp parallel for num_threads(numThreads) schedule(static)
+    for (int j = 0; j <= ny; j++) {
+        if (j == 0 || j == ny) {
+            for (int i = 0; i <= nx; i++) applyNode(i, j, x, y);
+            continue;
+        }
+        
+        applyNode(0, j, x, y);
+        
+        #pragma omp simd
+        for (int i = 1; i < nx; i++) {
+            int p = j * stride + i;
+            double yu = 0.0, yv = 0.0;
+            for (int k = 0; k < NUM_OFFSETS; k++) {
+                int q = p + nodeOffset[k];
+                double xu = xr[2 * q];
+                double xv = xr[2 * q + 1];
+                yu += c[k][0] * xu + c[k][1] * xv;
+                yv += c[k][2] * xu + c[k][3] * xv;
+            }
+            yr[2 * p] = yu;
+            yr[2 * p + 1] = yv;
+        }
+        
+        if (nx > 0) applyNode(nx, j, x, y);
+    }
+    
+    // Dirichlet corrections: remove the constrained columns from neighbouring rows...
+    for (int d : fixedDOFs) {
+        int p = d / 2;
+        int comp = d % 2;
+        int i = p % stride;
+        int j = p / stride;
+        double xd = x[d];
+        
+        for (int dj = -1; dj <= 1; dj++) {
+            int qj = j + dj;
+            if (qj < 0 || qj > ny) continue;
+            for (int di = -1; di <= 1; di++) {
+                int qi = i + di;
+                if (qi < 0 || qi > nx) continue;
+                
+                // Row q sees node p at offset (-di, -dj)
+                const double* cq = coeff[nodeClass(qi, qj)][offsetIndex(-di, -dj)];
+                int q = qj * stride + qi;
+                y[2 * q]     -= cq[comp] * xd;
+                y[2 * q + 1] -= cq[2 + comp] * xd;
+            }
+        }
+    }
+    
+    // ...and make the constrained rows identity rows
+    for (int d : fixedDOFs) {
+        y[d] = x[d];
+    }
+}
+
+double StencilOperator::memoryBytes() const {
+    return sizeof(coeff) + fixedDOFs.size() * sizeof(int) + latticeToNode.size() * sizeof(int) +
+           (xLattice.size() + yLattice.size()) * sizeof(double);
+}
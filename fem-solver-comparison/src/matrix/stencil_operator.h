@@ -0,0 +1,55 @@
+#ifndef STENCIL_OPERATOR_H
+#define STENCIL_OPERATOR_H
+
+#include <vector>
+#include <string>
+#include "stiffness_matrix.h"
+#include "../solvers/linear_operator.h"
+
+// Constant-coefficient stencil form of K for the structured grid built by
+// generateMesh(). Every node couples to its 3x3 lattice neighbourhood through
+// 2x2 blocks that depend only on which of the four surrounding elements exist,
+// so nine node classes x nine offsets x 2x2 coefficients describe all of K.
+// Dirichlet DOFs are handled as corrections after the sweep. The sweep runs
+// in lattice order; renumbered meshes are gathered into and scattered out of it.
+class StencilOperator : public LinearOperator {
+public:
+    // Throws std::invalid_argument unless every element has the same Ke
+    StencilOperator(StiffnessMatrix& mesh, const std::vector<int>& fixedDOFs, int numThreads = 1);
+    
+    int size() const override { return 2 * (nx + 1) * (ny + 1); }
+    void apply(const std::vector<double>& x, std::vector<double>& y) const override;
+    double memoryBytes() const override;
+    std::string getName() const override { return "Stencil"; }
+    
+private:
+    static constexpr int NUM_CLASSES = 9;
+    static constexpr int NUM_OFFSETS = 9;
+    
+    int nx, ny;
+    int numThreads;
+    std::vector<int> fixedDOFs;       // In lattice DOF numbering
+    std::vector<int> latticeToNode;   // Empty when the mesh is in lattice order
+    mutable std::vector<double> xLattice, yLattice;
+    
+    // coeff[cls][offset][r * 2 + c]: row DOF r of the node, column DOF c of the neighbour
+    double coeff[NUM_CLASSES][NUM_OFFSETS][4];
+    
+    // Class 0..8 from position: 3 * (y class) + (x class), x/y class 0 = low edge, 1 = interior, 2 = high edge
+    int nodeClass(int i, int j) const {
+        int cx = (i == 0) ? 0 : (i == nx ? 2 : 1);
+        int cy = (j == 0) ? 0 : (j == ny ? 2 : 1);
+        return 3 * cy + cx;
+    }
+    
+    // Offset index 0..8 for (di, dj) in {-1, 0, 1}^2
+    static int offsetIndex(int di, int dj) { return 3 * (dj + 1) + (di + 1); }
+    
+    // K*x with x and y in lattice DOF numbering
+    void applyLattice(const std::vector<double>& x, std::vector<double>& y) const;
+    
+    // General row evaluation with bounds checks (boundary nodes)
+    void applyNode(int i, int j, const std::vector<double>& x, std::vector<double>& y) const;
+};
+
+#endif
@@ -3,6 +3,11 @@
 
 #include <vector>
 #include <cmath>
+#include "element_kernel.h"
+#include "element_cache.h"
+#include "dense_matrix.h"
+#include "csr_matrix.h"
+#include "bsr_matrix.h"
 
 class StiffnessMatrix {
 public:
@@ -12,30 +17,78 @@ public:
         double nu; // Poisson's ratio
         double t;  // Thickness (m)
     };
-
+    
     // Node coordinates
     struct Node {
         double x, y;
         int id;
     };
-
+    
     // Element definition (4-node quadrilateral)
     struct Element {
         int nodes[4];  // Node IDs (counter-clockwise)
         int id;
     };
-
+    
     StiffnessMatrix(int nx, int ny, double width, double height, MaterialProperties mat);
     
     // Generate mesh
     void generateMesh();
     
-    // Assemble global stiffness matrix
-    void assembleGlobalStiffness();
+    // Renumber nodes by reverse Cuthill-McKee to shrink the bandwidth and profile of K
+    // (call before assembly; reports the envelope before and after)
+    void renumberNodesRCM();
+    
+    // Apply a node permutation: node p becomes node newId[p]
+    void permuteNodes(const std::vector<int>& newId);
+    
+    // Assemble global stiffness matrix (dense, for small comparison runs)
+    void assembleGlobalStiffness(int numThreads = 1);
+    
+    // Assemble global stiffness matrix directly into CSR storage
+    void assembleGlobalStiffnessSparse(int numThreads = 1);
+    
+    // Assemble global stiffness matrix into 2x2 block CSR (one block per node coupling)
+    void assembleGlobalStiffnessBSR(int numThreads = 1);
     
     // Get element stiffness matrix (8x8 for 4-node quad)
     std::vector<std::vector<double>> getElementStiffness(int elemId);
     
+    // Element stiffness through the allocation-free fixed-size kernel
+    void computeElementStiffness(int elemId, ElementKernel::Matrix8& Ke) const;
+    
+    // Gather the corner coordinates of an element
+    void getElementCoordinates(int elemId, double x[4], double y[4]) const;
+    
+    // Gather up to ElementKernel::BATCH elements into SoA lanes (unused lanes repeat the first)
+    void gatherElementBatch(const int* elemIds, int count, ElementKernel::ElementBatch& batch) const;
+    
+    // Compute uncached Ke with the SIMD-batched kernel (on by default) or one element at a time
+    void setBatchedKernelEnabled(bool enabled) { useBatchedKernel = enabled; }
+    
+    // Reuse Ke for geometrically identical elements during assembly (on by default)
+    void setElementCacheEnabled(bool enabled) { useKeCache = enabled; }
+    // Also drops the per-element pointers into the cache
+    void clearElementCache() {
+        elementKe.clear();
+        keCache.clear();
+    }
+    ElementStiffnessCache::Statistics getElementCacheStatistics() const { return keCache.getStatistics(); }
+    
+    // Point every element at its cache entry, computing new entries in parallel
+    // (done by the assembly routines; call again after moving nodes)
+    void resolveElementStiffness(int numThreads = 1);
+    
+    // True while every element points at its cache entry (one pointer per element)
+    bool hasResolvedElementStiffness() const { return !elementKe.empty(); }
+    
+    // Cached Ke of an element, or computed into scratch when caching is off
+    const ElementKernel::Matrix8& elementStiffness(int elemId, ElementKernel::Matrix8& scratch) const;
+    
+    // Randomly move a fraction of interior nodes by up to amplitude * element size
+    // (gives mildly irregular meshes for benchmarking)
+    void perturbInteriorNodes(double amplitude, double fraction, unsigned seed = 1);
+    
     // Get constitutive matrix [D] for plane stress
     std::vector<std::vector<double>> getConstitutiveMatrix();
     
@@ -43,28 +96,60 @@ public:
     void shapeFunction(double xi, double eta, double N[4]);
     void shapeFunctionDerivatives(double xi, double eta, double dN_dxi[4], double dN_deta[4]);
     
-    // Gauss quadrature integration
+    // Gauss quadrature integration (reference implementation on heap matrices)
     void gaussQuadrature2D(std::vector<std::vector<double>>& Ke, int elemId);
     
     // Getters
     int getNumNodes() const { return nodes.size(); }
     int getNumElements() const { return elements.size(); }
     int getNumDOF() const { return 2 * nodes.size(); }
-    std::vector<std::vector<double>>& getGlobalK() { return K_global; }
+    int getNx() const { return nx; }
+    int getNy() const { return ny; }
+    // Node ID at lattice position (i, j), 0 <= i <= nx, 0 <= j <= ny
+    int latticeNode(int i, int j) const { return latticeToNode[j * (nx + 1) + i]; }
+    DenseMatrix& getGlobalK() { return K_global; }
+    CSRMatrix& getGlobalKSparse() { return K_sparse; }
+    BSRMatrix& getGlobalKBSR() { return K_bsr; }
     const std::vector<Node>& getNodes() const { return nodes; }
     const std::vector<Element>& getElements() const { return elements; }
+    const std::vector<std::vector<int>>& getElementColors() const { return elementColors; }
     
     // Compute B matrix (strain-displacement)
     void computeBMatrix(double xi, double eta, int elemId, std::vector<std::vector<double>>& B);
-    
+
 private:
     int nx, ny;  // Number of elements in x and y
     double width, height;
     MaterialProperties material;
+    ElementKernel::Matrix3 D_plane;  // Constitutive matrix, built once
     
     std::vector<Node> nodes;
     std::vector<Element> elements;
-    std::vector<std::vector<double>> K_global;
+    std::vector<int> latticeToNode;  // Node ID of lattice point j * (nx + 1) + i
+    std::vector<std::vector<int>> elementColors;  // No two elements of a color share a node
+    DenseMatrix K_global;
+    CSRMatrix K_sparse;
+    BSRMatrix K_bsr;
+    
+    ElementStiffnessCache keCache;
+    bool useKeCache;
+    bool useBatchedKernel;
+    std::vector<const ElementKernel::Matrix8*> elementKe;  // Cache entry per element
+    
+    // Visit every element color by color (parallel within a color) and hand its Ke to
+    // scatter(elemId, Ke, stride), where entry (m, n) is Ke[(m * 8 + n) * stride]
+    template <typename Scatter>
+    void forEachElementStiffness(int numThreads, Scatter scatter) const;
+    
+    // Sorted, unique nodes coupled to each node through its elements (self included),
+    // node n's list at neighbours[start[n]..start[n + 1])
+    void nodeNeighbours(std::vector<int>& start, std::vector<int>& neighbours) const;
+    
+    // Build CSR sparsity pattern of K from element connectivity
+    void buildSparsityPattern(CSRMatrix& K) const;
+    
+    // Same pattern with one 2x2 block per node coupling
+    void buildBlockPattern(BSRMatrix& K) const;
     
     // Jacobian matrix
     void computeJacobian(double xi, double eta, int elemId, 
@@ -0,0 +1,87 @@
+#include "bsr_solver.h"
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+BSRSolver::BSRMatrix BSRSolver::fromCSR(const SparseSolver::SparseMatrix& A) {
+    BSRMatrix B;
+    B.numBlockRows = A.n / BLOCK;
+    B.rowPointers.assign(B.numBlockRows + 1, 0);
+    
+    std::vector<int> blockCols;
+    for (int I = 0; I < B.numBlockRows; I++) {
+        blockCols.clear();
+        for (int i = BLOCK * I; i < BLOCK * (I + 1); i++) {
+            for (int k = A.rowPointers[i]; k < A.rowPointers[i + 1]; k++) {
+                blockCols.push_back(A.colIndices[k] / BLOCK);
+            }
+        }
+        std::sort(blockCols.begin(), blockCols.end());
+        blockCols.erase(std::unique(blockCols.begin(), blockCols.end()), blockCols.end());
+        
+        int first = B.colIndices.size();
+        B.colIndices.insert(B.colIndices.end(), blockCols.begin(), blockCols.end());
+        B.values.resize(4 * B.colIndices.size(), 0.0);
+        
+        for (int r = 0; r < BLOCK; r++) {
+            int i = BLOCK * I + r;
+            for (int k = A.rowPointers[i]; k < A.rowPointers[i + 1]; k++) {
+                int J = A.colIndices[k] / BLOCK;
+                int pos = std::lower_bound(B.colIndices.begin() + first, B.colIndices.end(), J) -
+                          B.colIndices.begin();
+                B.values[4 * pos + BLOCK * (A.colIndices[k] % BLOCK) + r] = A.values[k];
+            }
+        }
+        
+        B.rowPointers[I + 1] = B.colIndices.size();
+    }
+    
+    return B;
+}
+
+void BSRSolver::multiply(const BSRMatrix& A, const std::vector<double>& x, std::vector<double>& y) {
+    const double* v = A.values.data();
+    const int* col = A.colIndices.data();
+    
+    for (int I = 0; I < A.numBlockRows; I++) {
+#if defined(__SSE2__)
+        // y_I += a_col0 * x_J0 + a_col1 * x_J1, both block columns in one register each
+        __m128d acc = _mm_setzero_pd();
+        for (int k = A.rowPointers[I]; k < A.rowPointers[I + 1]; k++) {
+            const double* xj = &x[BLOCK * col[k]];
+            __m128d c0 = _mm_loadu_pd(v + 4 * k);
+            __m128d c1 = _mm_loadu_pd(v + 4 * k + 2);
+#if defined(__FMA__)
+            acc = _mm_fmadd_pd(c0, _mm_set1_pd(xj[0]), acc);
+            acc = _mm_fmadd_pd(c1, _mm_set1_pd(xj[1]), acc);
+#else
+            acc = _mm_add_pd(acc, _mm_mul_pd(c0, _mm_set1_pd(xj[0])));
+            acc = _mm_add_pd(acc, _mm_mul_pd(c1, _mm_set1_pd(xj[1])));
+#endif
+        }
+        _mm_storeu_pd(&y[BLOCK * I], acc);
+#else
+        double y0 = 0.0, y1 = 0.0;
+        for (int k = A.rowPointers[I]; k < A.rowPointers[I + 1]; k++) {
+            const double* b = v + 4 * k;
+            double x0 = x[BLOCK * col[k]], x1 = x[BLOCK * col[k] + 1];
+            y0 += b[0] * x0 + b[2] * x1;
+            y1 += b[1] * x0 + b[3] * x1;
+        }
+        y[BLOCK * I] = y0;
+        y[BLOCK * I + 1] = y1;
+#endif
+    }
+}
+
+double BSRSolver::memoryBytes(const BSRMatrix& A) {
+    return (double)A.values.size() * sizeof(double) +
+           (double)A.colIndices.size() * sizeof(int) +
+           (double)A.rowPointers.size() * sizeof(int);
+}
+
+void BSROperator::apply(const std::vector<double>& x, std::vector<double>& y) const {
+    BSRSolver::multiply(A, x, y);
+}
@@ -1,12 +1,17 @@
 #include "efficient_solver.h"
+#include "tiled_dense.h"
+#include "bsr_solver.h"
+#include "sell_solver.h"
+#include "float32_storage.h"
 #include <iostream>
 #include <cmath>
 #include <iomanip>
 #include <algorithm>
+#include <omp.h>
 
 // ============== LU DECOMPOSITION ==============
 
-std::vector<double> LUSolver::solve(std::vector<std::vector<double>>& K, 
+std::vector<double> LUSolver::solve(DenseMatrix& K, 
                                      std::vector<double>& F,
                                      bool verbose) {
     int n = F.size();
@@ -16,12 +21,9 @@ std::vector<double> LUSolver::solve(std::vector<std::vector<double>>& K,
         std::cout << "System size: " << n << " x " << n << std::endl;
     }
     
-    auto A = K;
-    std::vector<int> perm(n);
-    for (int i = 0; i < n; i++) perm[i] = i;
-    
-    decompose(A, perm);
-    auto solution = solveLU(A, perm, F);
+    LUFactorization factors;
+    factors.factorize(K);
+    auto solution = factors.solve(F);
     
     if (verbose) {
         std::cout << "Solution computed successfully" << std::endl;
@@ -30,8 +32,58 @@ std::vector<double> LUSolver::solve(std::vector<std::vector<double>>& K,
     return solution;
 }
 
-void LUSolver::decompose(std::vector<std::vector<double>>& A, std::vector<int>& perm) {
-    int n = A.size();
+void LUSolver::decompose(DenseMatrix& A, std::vector<int>& perm, const DenseKernels::Tiling& tiling) {
+    int n = A.rows();
+    int nb = std::max(1, tiling.panel);
+    const DenseMatrix& cA = A;
+    
+    for (int k0 = 0; k0 < n; k0 += nb) {
+        int end = std::min(k0 + nb, n);
+        
+        // Panel: unblocked LU of columns k0..end-1, rows k0..n-1
+        for (int k = k0; k < end; k++) {
+            double maxVal = std::abs(A[k][k]);
+            int maxRow = k;
+            
+            for (int i = k + 1; i < n; i++) {
+                if (std::abs(A[i][k]) > maxVal) {
+                    maxVal = std::abs(A[i][k]);
+                    maxRow = i;
+                }
+            }
+            
+            if (maxRow != k) {
+                A.swapRows(k, maxRow);
+                std::swap(perm[k], perm[maxRow]);
+            }
+            
+            const double* Ak = A[k];
+            if (std::abs(Ak[k]) <= 1e-15) continue;
+            
+            for (int i = k + 1; i < n; i++) {
+                double* Ai = A[i];
+                double lik = Ai[k] / Ak[k];
+                Ai[k] = lik;
+                
+                for (int j = k + 1; j < end; j++) {
+                    Ai[j] -= lik * Ak[j];
+                }
+            }
+        }
+        
+        if (end == n) break;
+        
+        // U block row: A12 <- L11^-1 A12 (L11 unit lower triangular)
+        DenseKernels::trsmLeftUnitLower(cA.block(k0, k0, end - k0, end - k0), A.block(k0, end, end - k0, n - end));
+        
+        // Trailing matrix: A22 -= L21 U12
+        DenseKernels::gemmSubtract(cA.block(end, k0, n - end, end - k0), cA.block(k0, end, end - k0, n - end),
+                                   false, A.block(end, end, n - end, n - end), tiling);
+    }
+}
+
+void LUSolver::decomposeUnblocked(DenseMatrix& A, std::vector<int>& perm) {
+    int n = A.rows();
     
     for (int k = 0; k < n; k++) {
         // Partial pivoting
@@ -46,24 +98,27 @@ void LUSolver::decompose(std::vector<std::vector<double>>& A, std::vector<int>&
         }
         
         if (maxRow != k) {
-            std::swap(A[k], A[maxRow]);
+            A.swapRows(k, maxRow);
             std::swap(perm[k], perm[maxRow]);
         }
         
         // LU decomposition
+        const double* Ak = A[k];
         for (int i = k + 1; i < n; i++) {
-            if (std::abs(A[k][k]) > 1e-15) {
-                A[i][k] /= A[k][k];
+            if (std::abs(Ak[k]) > 1e-15) {
+                double* Ai = A[i];
+                double lik = Ai[k] / Ak[k];
+                Ai[k] = lik;
                 
                 for (int j = k + 1; j < n; j++) {
-                    A[i][j] -= A[i][k] * A[k][j];
+                    Ai[j] -= lik * Ak[j];
                 }
             }
         }
     }
 }
 
-std::vector<double> LUSolver::solveLU(const std::vector<std::vector<double>>& LU,
+std::vector<double> LUSolver::solveLU(const DenseMatrix& LU,
                                        const std::vector<int>& perm,
                                        const std::vector<double>& b) {
     int n = b.size();
@@ -92,7 +147,7 @@ std::vector<double> LUSolver::solveLU(const std::vector<std::vector<double>>& LU
 
 // ============== CHOLESKY DECOMPOSITION ==============
 
-std::vector<double> CholeskySolver::solve(std::vector<std::vector<double>>& K, 
+std::vector<double> CholeskySolver::solve(DenseMatrix& K, 
                                            std::vector<double>& F,
                                            bool verbose) {
     int n = F.size();
@@ -102,14 +157,13 @@ std::vector<double> CholeskySolver::solve(std::vector<std::vector<double>>& K,
         std::cout << "System size: " << n << " x " << n << std::endl;
     }
     
-    auto A = K;
-    
-    if (!decompose(A)) {
+    CholeskyFactorization factors;
+    if (!factors.factorize(K)) {
         std::cerr << "Cholesky decomposition failed (matrix not positive definite)" << std::endl;
         return std::vector<double>(n, 0.0);
     }
     
-    auto solution = solveCholesky(A, F);
+    auto solution = factors.solve(F);
     
     if (verbose) {
         std::cout << "Solution computed successfully" << std::endl;
@@ -118,27 +172,60 @@ std::vector<double> CholeskySolver::solve(std::vector<std::vector<double>>& K,
     return solution;
 }
 
-bool CholeskySolver::decompose(std::vector<std::vector<double>>& A) {
-    int n = A.size();
+bool CholeskySolver::decompose(DenseMatrix& A, const DenseKernels::Tiling& tiling) {
+    int n = A.rows();
+    int nb = std::max(1, tiling.panel);
+    int strip = std::max(nb, tiling.rowBlock);
+    const DenseMatrix& cA = A;
+    
+    for (int k0 = 0; k0 < n; k0 += nb) {
+        int end = std::min(k0 + nb, n);
+        
+        if (!decomposeUnblocked(A.block(k0, k0, end - k0, end - k0))) {
+            return false;
+        }
+        
+        if (end == n) break;
+        
+        // Panel below the diagonal block: L21 = A21 L11^-T
+        DenseKernels::trsmRightLowerTranspose(cA.block(k0, k0, end - k0, end - k0), A.block(end, k0, n - end, end - k0));
+        
+        // Trailing lower triangle: A22 -= L21 L21^T in strips of rows, each updated
+        // up to its last column (the upper part of A is never read)
+        for (int i0 = end; i0 < n; i0 += strip) {
+            int rows = std::min(strip, n - i0);
+            int cols = i0 + rows - end;
+            DenseKernels::gemmSubtract(cA.block(i0, k0, rows, end - k0), cA.block(end, k0, cols, end - k0),
+                                       true, A.block(i0, end, rows, cols), tiling);
+        }
+    }
+    
+    return true;
+}
+
+bool CholeskySolver::decomposeUnblocked(DenseMatrix::View A) {
+    int n = A.rows;
     
     for (int i = 0; i < n; i++) {
+        double* Ai = A[i];
         for (int j = 0; j <= i; j++) {
-            double sum = A[i][j];
+            const double* Aj = A[j];
+            double sum = Ai[j];
             
             for (int k = 0; k < j; k++) {
-                sum -= A[i][k] * A[j][k];
+                sum -= Ai[k] * Aj[k];
             }
             
             if (i == j) {
                 if (sum <= 0.0) {
                     return false;  // Not positive definite
                 }
-                A[i][j] = sqrt(sum);
+                Ai[j] = sqrt(sum);
             } else {
-                if (std::abs(A[j][j]) < 1e-15) {
+                if (std::abs(Aj[j]) < 1e-15) {
                     return false;
                 }
-                A[i][j] = sum / A[j][j];
+                Ai[j] = sum / Aj[j];
             }
         }
     }
@@ -146,7 +233,7 @@ bool CholeskySolver::decompose(std::vector<std::vector<double>>& A) {
     return true;
 }
 
-std::vector<double> CholeskySolver::solveCholesky(const std::vector<std::vector<double>>& L,
+std::vector<double> CholeskySolver::solveCholesky(const DenseMatrix& L,
                                                    const std::vector<double>& b) {
     int n = b.size();
     std::vector<double> y(n), x(n);
@@ -172,18 +259,67 @@ std::vector<double> CholeskySolver::solveCholesky(const std::vector<std::vector<
     return x;
 }
 
+// ============== REUSABLE DENSE FACTORIZATIONS ==============
+
+bool LUFactorization::factorize(const DenseMatrix& K, int numThreads) {
+    int n = K.rows();
+    LU = K;
+    perm.resize(n);
+    for (int i = 0; i < n; i++) perm[i] = i;
+    
+    if (numThreads > 1) TiledDenseSolver::luDecompose(LU, perm, numThreads);
+    else LUSolver::decompose(LU, perm);
+    
+    factored = true;
+    for (int i = 0; i < n; i++) {
+        if (std::abs(LU[i][i]) < 1e-15) factored = false;
+    }
+    return factored;
+}
+
+std::vector<double> LUFactorization::solve(const std::vector<double>& b) const {
+    return LUSolver::solveLU(LU, perm, b);
+}
+
+double LUFactorization::memoryBytes() const {
+    return LU.memoryBytes() + perm.size() * sizeof(int);
+}
+
+bool CholeskyFactorization::factorize(const DenseMatrix& K, int numThreads) {
+    L = K;
+    factored = numThreads > 1 ? TiledDenseSolver::choleskyDecompose(L, numThreads)
+                              : CholeskySolver::decompose(L);
+    return factored;
+}
+
+std::vector<double> CholeskyFactorization::solve(const std::vector<double>& b) const {
+    return CholeskySolver::solveCholesky(L, b);
+}
+
+double CholeskyFactorization::memoryBytes() const {
+    return L.memoryBytes();
+}
+
 // ============== CONJUGATE GRADIENT ==============
 
-std::vector<double> ConjugateGradientSolver::solve(std::vector<std::vector<double>>& K, 
+std::vector<double> ConjugateGradientSolver::solve(DenseMatrix& K, 
                                                      std::vector<double>& F,
                                                      bool verbose,
                                                      double tolerance,
                                                      int maxIterations) {
+    return solve(DenseOperator(K), F, verbose, tolerance, maxIterations);
+}
+
+std::vector<double> ConjugateGradientSolver::solve(const LinearOperator& A, 
+                                                     const std::vector<double>& F,
+                                                     bool verbose,
+                                                     double tolerance,
+                                                     int maxIterations) {
     int n = F.size();
     
     if (verbose) {
         std::cout << "\n=== CONJUGATE GRADIENT ===" << std::endl;
-        std::cout << "System size: " << n << " x " << n << std::endl;
+        std::cout << "System size: " << n << " x " << n << " (" << A.getName() << " operator)" << std::endl;
         std::cout << "Tolerance: " << tolerance << ", Max iterations: " << maxIterations << std::endl;
     }
     
@@ -197,7 +333,7 @@ std::vector<double> ConjugateGradientSolver::solve(std::vector<std::vector<doubl
     
     int iter = 0;
     for (iter = 0; iter < maxIterations; iter++) {
-        matrixVectorMultiply(K, p, Ap);
+        A.apply(p, Ap);
         
         double alpha = rsold / dotProduct(p, Ap);
         
@@ -236,16 +372,10 @@ std::vector<double> ConjugateGradientSolver::solve(std::vector<std::vector<doubl
     return x;
 }
 
-void ConjugateGradientSolver::matrixVectorMultiply(const std::vector<std::vector<double>>& A,
+void ConjugateGradientSolver::matrixVectorMultiply(const DenseMatrix& A,
                                                     const std::vector<double>& x,
                                                     std::vector<double>& result) {
-    int n = x.size();
-    for (int i = 0; i < n; i++) {
-        result[i] = 0.0;
-        for (int j = 0; j < n; j++) {
-            result[i] += A[i][j] * x[j];
-        }
-    }
+    A.multiply(x, result);
 }
 
 double ConjugateGradientSolver::dotProduct(const std::vector<double>& a, 
@@ -259,19 +389,21 @@ double ConjugateGradientSolver::dotProduct(const std::vector<double>& a,
 
 // ============== SPARSE MATRIX SOLVER ==============
 
-std::vector<double> SparseSolver::solve(std::vector<std::vector<double>>& K, 
+std::vector<double> SparseSolver::solve(DenseMatrix& K, 
                                          std::vector<double>& F,
                                          bool verbose) {
     if (verbose) {
         std::cout << "\n=== SPARSE MATRIX SOLVER (CG) ===" << std::endl;
-        std::cout << "System size: " << K.size() << " x " << K.size() << std::endl;
+        std::cout << "System size: " << K.rows() << " x " << K.cols() << std::endl;
     }
     
     auto sparseK = convertToSparse(K);
     
     if (verbose) {
-        double sparsity = 100.0 * (1.0 - (double)sparseK.values.size() / (K.size() * K.size()));
-        std::cout << "Sparsity: " << std::fixed << std::setprecision(2) << sparsity << "%" << std::endl;
+        double sparsity = 100.0 * (1.0 - (double)sparseK.values.size() / ((double)K.rows() * K.cols()));
+        std::streamsize precision = std::cout.precision();
+        std::cout << "Sparsity: " << std::fixed << std::setprecision(2) << sparsity << "%"
+                  << std::defaultfloat << std::setprecision(precision) << std::endl;
         std::cout << "Non-zero elements: " << sparseK.values.size() << std::endl;
     }
     
@@ -280,16 +412,34 @@ std::vector<double> SparseSolver::solve(std::vector<std::vector<double>>& K,
     return solution;
 }
 
-SparseSolver::SparseMatrix SparseSolver::convertToSparse(const std::vector<std::vector<double>>& K,
+std::vector<double> SparseSolver::solve(const SparseMatrix& K, 
+                                         const std::vector<double>& F,
+                                         bool verbose,
+                                         int* iterations) {
+    if (verbose) {
+        std::cout << "\n=== SPARSE MATRIX SOLVER (CG) ===" << std::endl;
+        std::cout << "System size: " << K.n << " x " << K.n << std::endl;
+        double sparsity = 100.0 * (1.0 - (double)K.values.size() / ((double)K.n * K.n));
+        std::streamsize precision = std::cout.precision();
+        std::cout << "Sparsity: " << std::fixed << std::setprecision(2) << sparsity << "%"
+                  << std::defaultfloat << std::setprecision(precision) << std::endl;
+        std::cout << "Non-zero elements: " << K.values.size() << std::endl;
+    }
+    
+    return sparseCG(K, F, verbose, iterations);
+}
+
+SparseSolver::SparseMatrix SparseSolver::convertToSparse(const DenseMatrix& K,
                                                           double threshold) {
     SparseMatrix sparse;
-    sparse.n = K.size();
+    sparse.n = K.rows();
     sparse.rowPointers.push_back(0);
     
     for (int i = 0; i < sparse.n; i++) {
+        const double* Ki = K[i];
         for (int j = 0; j < sparse.n; j++) {
-            if (std::abs(K[i][j]) > threshold) {
-                sparse.values.push_back(K[i][j]);
+            if (std::abs(Ki[j]) > threshold) {
+                sparse.values.push_back(Ki[j]);
                 sparse.colIndices.push_back(j);
             }
         }
@@ -299,33 +449,416 @@ SparseSolver::SparseMatrix SparseSolver::convertToSparse(const std::vector<std::
     return sparse;
 }
 
+// y = A x on rows begin..end-1
+static void matVecRows(const SparseSolver::SparseMatrix& A, const double* x, double* y, int begin, int end) {
+    for (int i = begin; i < end; i++) {
+        double sum = 0.0;
+        for (int j = A.rowPointers[i]; j < A.rowPointers[i + 1]; j++) {
+            sum += A.values[j] * x[A.colIndices[j]];
+        }
+        y[i] = sum;
+    }
+}
+
 void SparseSolver::sparseMatVecMult(const SparseMatrix& A, const std::vector<double>& x,
                                     std::vector<double>& result) {
+    matVecRows(A, x.data(), result.data(), 0, A.n);
+}
+
+std::vector<int> SparseSolver::balancedRowPartition(const SparseMatrix& A, int parts) {
+    std::vector<int> partition(parts + 1, A.n);
+    partition[0] = 0;
+    long long nnz = A.rowPointers[A.n];
+    
+    // Range t starts at the first row whose entries begin at or after t * nnz / parts
+    for (int t = 1; t < parts; t++) {
+        long long target = nnz * t / parts;
+        partition[t] = std::lower_bound(A.rowPointers.begin(), A.rowPointers.begin() + A.n, target) -
+                       A.rowPointers.begin();
+    }
+    
+    return partition;
+}
+
+void SparseSolver::parallelMatVecMult(const SparseMatrix& A, const std::vector<double>& x,
+                                      std::vector<double>& result, const std::vector<int>& partition) {
+    int numThreads = partition.size() - 1;
+    
+    #pragma omp parallel num_threads(numThreads)
+    {
+        int t = omp_get_thread_num();
+        matVecRows(A, x.data(), result.data(), partition[t], partition[t + 1]);
+    }
+}
+
+// Fixed vector count keeps the k accumulators in registers
+template <int K>
+static void multiVecKernel(const SparseSolver::SparseMatrix& A, const double* X, double* Y) {
     for (int i = 0; i < A.n; i++) {
-        result[i] = 0.0;
-        for (int j = A.rowPointers[i]; j < A.rowPointers[i + 1]; j++) {
-            result[i] += A.values[j] * x[A.colIndices[j]];
+        double acc[K] = {};
+        for (int p = A.rowPointers[i]; p < A.rowPointers[i + 1]; p++) {
+            double a = A.values[p];
+            const double* x = X + (size_t)A.colIndices[p] * K;
+            for (int j = 0; j < K; j++) acc[j] += a * x[j];
+        }
+        for (int j = 0; j < K; j++) Y[(size_t)i * K + j] = acc[j];
+    }
+}
+
+void SparseSolver::sparseMatMultiVec(const SparseMatrix& A, const std::vector<double>& X,
+                                     std::vector<double>& Y, int k) {
+    switch (k) {
+        case 1: multiVecKernel<1>(A, X.data(), Y.data()); return;
+        case 2: multiVecKernel<2>(A, X.data(), Y.data()); return;
+        case 3: multiVecKernel<3>(A, X.data(), Y.data()); return;
+        case 4: multiVecKernel<4>(A, X.data(), Y.data()); return;
+        case 5: multiVecKernel<5>(A, X.data(), Y.data()); return;
+        case 6: multiVecKernel<6>(A, X.data(), Y.data()); return;
+        case 7: multiVecKernel<7>(A, X.data(), Y.data()); return;
+        case 8: multiVecKernel<8>(A, X.data(), Y.data()); return;
+    }
+    
+    // Wider blocks in chunks of 8 vectors
+    std::vector<double> Xc((size_t)A.n * 8), Yc((size_t)A.n * 8);
+    for (int j0 = 0; j0 < k; j0 += 8) {
+        int w = std::min(8, k - j0);
+        for (int i = 0; i < A.n; i++) {
+            for (int j = 0; j < 8; j++) Xc[(size_t)i * 8 + j] = j < w ? X[(size_t)i * k + j0 + j] : 0.0;
+        }
+        multiVecKernel<8>(A, Xc.data(), Yc.data());
+        for (int i = 0; i < A.n; i++) {
+            for (int j = 0; j < w; j++) Y[(size_t)i * k + j0 + j] = Yc[(size_t)i * 8 + j];
+        }
+    }
+}
+
+SparseSolver::SparseMatrix SparseSolver::multiply(const SparseMatrix& A, const SparseMatrix& B,
+                                                  int numCols) {
+    SparseMatrix C;
+    C.n = A.n;
+    C.rowPointers.assign(A.n + 1, 0);
+    
+    // Row by row with a dense accumulator (Gustavson)
+    std::vector<double> accumulator(numCols, 0.0);
+    std::vector<int> marker(numCols, -1);
+    std::vector<int> pattern;
+    
+    for (int i = 0; i < A.n; i++) {
+        pattern.clear();
+        for (int ka = A.rowPointers[i]; ka < A.rowPointers[i + 1]; ka++) {
+            int k = A.colIndices[ka];
+            double aik = A.values[ka];
+            for (int kb = B.rowPointers[k]; kb < B.rowPointers[k + 1]; kb++) {
+                int j = B.colIndices[kb];
+                if (marker[j] != i) {
+                    marker[j] = i;
+                    accumulator[j] = 0.0;
+                    pattern.push_back(j);
+                }
+                accumulator[j] += aik * B.values[kb];
+            }
+        }
+        
+        std::sort(pattern.begin(), pattern.end());
+        for (int j : pattern) {
+            C.colIndices.push_back(j);
+            C.values.push_back(accumulator[j]);
         }
+        C.rowPointers[i + 1] = C.colIndices.size();
     }
+    
+    return C;
+}
+
+SparseSolver::SparseMatrix SparseSolver::transpose(const SparseMatrix& A, int numCols) {
+    SparseMatrix T;
+    T.n = numCols;
+    T.rowPointers.assign(numCols + 1, 0);
+    T.colIndices.resize(A.values.size());
+    T.values.resize(A.values.size());
+    
+    for (int j : A.colIndices) T.rowPointers[j + 1]++;
+    for (int j = 0; j < numCols; j++) T.rowPointers[j + 1] += T.rowPointers[j];
+    
+    // Rows of A in order keep the columns of T sorted
+    std::vector<int> next(T.rowPointers.begin(), T.rowPointers.end() - 1);
+    for (int i = 0; i < A.n; i++) {
+        for (int k = A.rowPointers[i]; k < A.rowPointers[i + 1]; k++) {
+            int pos = next[A.colIndices[k]]++;
+            T.colIndices[pos] = i;
+            T.values[pos] = A.values[k];
+        }
+    }
+    
+    return T;
 }
 
 std::vector<double> SparseSolver::sparseCG(const SparseMatrix& A, 
                                            const std::vector<double>& b,
-                                           bool verbose) {
+                                           bool verbose,
+                                           int* iterations,
+                                           SpMVFormat format) {
+    if (format == SpMVFormat::BSR) {
+        BSRSolver::BSRMatrix B = BSRSolver::fromCSR(A);
+        return sparseCG(BSROperator(B), b, verbose, iterations);
+    }
+    if (format == SpMVFormat::SELL) {
+        SELLSolver::SELLMatrix S = SELLSolver::fromCSR(A);
+        return sparseCG(SELLOperator(S), b, verbose, iterations);
+    }
+    if (format == SpMVFormat::CSR_FLOAT) {
+        Float32Solver::CSRMatrix S = Float32Solver::fromCSR(A, true);
+        return sparseCG(CSR32Operator(S), b, verbose, iterations);
+    }
+    if (format == SpMVFormat::BSR_FLOAT) {
+        Float32Solver::BSRMatrix B = Float32Solver::fromBSR(BSRSolver::fromCSR(A), true);
+        return sparseCG(BSR32Operator(B), b, verbose, iterations);
+    }
+    return sparseCG(CSROperator(A), b, verbose, iterations);
+}
+
+std::vector<double> SparseSolver::sparseCG(const LinearOperator& A, 
+                                           const std::vector<double>& b,
+                                           bool verbose,
+                                           int* iterations) {
+    return preconditionedCG(A, nullptr, b, verbose, iterations);
+}
+
+std::vector<double> SparseSolver::parallelCG(const SparseMatrix& A,
+                                             const std::vector<double>& b,
+                                             int numThreads,
+                                             bool verbose,
+                                             int* iterations,
+                                             int maxIterations) {
+    int n = A.n;
+    std::vector<int> partition = balancedRowPartition(A, numThreads);
+    std::vector<double> x(n), r(n), p(n), Ap(n);
+    
+    // One cache line per thread so partial sums do not share lines
+    struct alignas(64) Partial { double value; };
+    std::vector<Partial> rr(numThreads), pAp(numThreads);
+    auto total = [numThreads](const std::vector<Partial>& partials) {
+        double sum = 0.0;
+        for (int t = 0; t < numThreads; t++) sum += partials[t].value;
+        return sum;
+    };
+    
+    double tolerance = 1e-8;
+    int iterationCount = maxIterations;
+    
+    if (verbose) {
+        std::cout << "\n=== PARALLEL SPARSE CG ===" << std::endl;
+        std::cout << "System size: " << n << " x " << n << ", threads: " << numThreads
+                  << ", nnz per thread: " << A.values.size() / numThreads << std::endl;
+    }
+    
+    #pragma omp parallel num_threads(numThreads)
+    {
+        int t = omp_get_thread_num();
+        int begin = partition[t], end = partition[t + 1];
+        
+        // Each thread first touches the rows it owns
+        double sum = 0.0;
+        for (int i = begin; i < end; i++) {
+            x[i] = 0.0;
+            r[i] = b[i];
+            p[i] = b[i];
+            sum += r[i] * r[i];
+        }
+        rr[t].value = sum;
+        #pragma omp barrier
+        double rsold = total(rr);
+        
+        for (int iter = 0; iter < maxIterations; iter++) {
+            matVecRows(A, p.data(), Ap.data(), begin, end);
+            
+            sum = 0.0;
+            for (int i = begin; i < end; i++) sum += p[i] * Ap[i];
+            pAp[t].value = sum;
+            #pragma omp barrier
+            double alpha = rsold / total(pAp);
+            
+            sum = 0.0;
+            for (int i = begin; i < end; i++) {
+                x[i] += alpha * p[i];
+                r[i] -= alpha * Ap[i];
+                sum += r[i] * r[i];
+            }
+            rr[t].value = sum;
+            #pragma omp barrier
+            double rsnew = total(rr);
+            double residual = sqrt(rsnew);
+            
+            if (t == 0 && verbose && iter % 100 == 0) {
+                std::cout << "Iteration " << iter << ", Residual: " << residual << std::endl;
+            }
+            
+            if (residual < tolerance) {
+                if (t == 0) {
+                    iterationCount = iter + 1;
+                    if (verbose) std::cout << "Converged at iteration " << iter << std::endl;
+                }
+                break;
+            }
+            
+            double beta = rsnew / rsold;
+            for (int i = begin; i < end; i++) {
+                p[i] = r[i] + beta * p[i];
+            }
+            rsold = rsnew;
+            
+            // p must be complete before the next product reads it
+            #pragma omp barrier
+        }
+    }
+    
+    if (iterations) *iterations = iterationCount;
+    
+    return x;
+}
+
+std::vector<double> SparseSolver::pipelinedCG(const SparseMatrix& A,
+                                              const std::vector<double>& b,
+                                              int numThreads,
+                                              bool verbose,
+                                              int* iterations,
+                                              int replacementInterval,
+                                              int maxIterations) {
     int n = A.n;
+    std::vector<int> partition = balancedRowPartition(A, numThreads);
+    std::vector<double> x(n), r(n), p(n), s(n), z(n), q(n);
+    
+    // w and the partial sums alternate between two buffers: the products of
+    // iteration k read buffer k % 2 while the update writes the other one, so a
+    // thread may run ahead into its update without a second barrier
+    std::vector<double> w[2] = {std::vector<double>(n), std::vector<double>(n)};
+    struct alignas(64) Partial { double rr, wr; };
+    std::vector<Partial> partials[2] = {std::vector<Partial>(numThreads), std::vector<Partial>(numThreads)};
+    
+    double tolerance = 1e-8;
+    int iterationCount = maxIterations;
+    int replacements = 0;
+    
+    if (verbose) {
+        std::cout << "\n=== PIPELINED SPARSE CG ===" << std::endl;
+        std::cout << "System size: " << n << " x " << n << ", threads: " << numThreads
+                  << ", residual replacement every " << replacementInterval << " iterations" << std::endl;
+    }
+    
+    #pragma omp parallel num_threads(numThreads)
+    {
+        int t = omp_get_thread_num();
+        int begin = partition[t], end = partition[t + 1];
+        
+        // (r, r) and (w, r) over this thread's rows into buffer k
+        auto partialSums = [&](int k) {
+            double rr = 0.0, wr = 0.0;
+            for (int i = begin; i < end; i++) {
+                rr += r[i] * r[i];
+                wr += w[k][i] * r[i];
+            }
+            partials[k][t] = {rr, wr};
+        };
+        
+        for (int i = begin; i < end; i++) {
+            x[i] = 0.0;
+            r[i] = b[i];
+            p[i] = s[i] = z[i] = 0.0;
+        }
+        #pragma omp barrier
+        matVecRows(A, r.data(), w[0].data(), begin, end);
+        partialSums(0);
+        
+        double alpha = 0.0, gammaOld = 0.0;
+        for (int iter = 0; iter < maxIterations; iter++) {
+            int cur = iter % 2, next = 1 - cur;
+            
+            // The only synchronization of a regular iteration: w and the partial sums are complete
+            #pragma omp barrier
+            double gamma = 0.0, delta = 0.0;
+            for (int k = 0; k < numThreads; k++) {
+                gamma += partials[cur][k].rr;
+                delta += partials[cur][k].wr;
+            }
+            double residual = sqrt(gamma);
+            
+            if (t == 0 && verbose && iter % 100 == 0) {
+                std::cout << "Iteration " << iter << ", Residual: " << residual << std::endl;
+            }
+            
+            if (residual < tolerance) {
+                if (t == 0) {
+                    iterationCount = iter;
+                    if (verbose) std::cout << "Converged at iteration " << iter << std::endl;
+                }
+                break;
+            }
+            
+            double beta = iter > 0 ? gamma / gammaOld : 0.0;
+            alpha = iter > 0 ? gamma / (delta - beta * gamma / alpha) : gamma / delta;
+            gammaOld = gamma;
+            
+            // q = A w does not depend on alpha or beta, which a distributed version
+            // would overlap with the reduction
+            matVecRows(A, w[cur].data(), q.data(), begin, end);
+            
+            for (int i = begin; i < end; i++) {
+                z[i] = q[i] + beta * z[i];
+                s[i] = w[cur][i] + beta * s[i];
+                p[i] = r[i] + beta * p[i];
+                x[i] += alpha * p[i];
+                r[i] -= alpha * s[i];
+                w[next][i] = w[cur][i] - alpha * z[i];
+            }
+            
+            if (replacementInterval > 0 && (iter + 1) % replacementInterval == 0) {
+                // Residual replacement: r = b - A x, s = A p, then w = A r, z = A s
+                #pragma omp barrier
+                matVecRows(A, x.data(), r.data(), begin, end);
+                for (int i = begin; i < end; i++) r[i] = b[i] - r[i];
+                matVecRows(A, p.data(), s.data(), begin, end);
+                #pragma omp barrier
+                matVecRows(A, r.data(), w[next].data(), begin, end);
+                matVecRows(A, s.data(), z.data(), begin, end);
+                if (t == 0) replacements++;
+            }
+            
+            partialSums(next);
+        }
+    }
+    
+    if (verbose) {
+        std::cout << "Residual replacements: " << replacements << std::endl;
+    }
+    
+    if (iterations) *iterations = iterationCount;
+    
+    return x;
+}
+
+std::vector<double> SparseSolver::preconditionedCG(const LinearOperator& A,
+                                                   const Preconditioner* M,
+                                                   const std::vector<double>& b,
+                                                   bool verbose,
+                                                   int* iterations) {
+    int n = A.size();
     std::vector<double> x(n, 0.0);
     std::vector<double> r = b;
-    std::vector<double> p = r;
+    std::vector<double> z(n);
     std::vector<double> Ap(n);
     
-    double rsold = ConjugateGradientSolver::dotProduct(r, r);
+    // Without a preconditioner z = r and r.z is the squared residual
+    if (M) M->apply(r, z);
+    std::vector<double> p = M ? z : r;
+    double rzold = ConjugateGradientSolver::dotProduct(r, M ? z : r);
     double tolerance = 1e-8;
     int maxIter = 10000;
+    int iter = 0;
     
-    for (int iter = 0; iter < maxIter; iter++) {
-        sparseMatVecMult(A, p, Ap);
+    for (; iter < maxIter; iter++) {
+        A.apply(p, Ap);
         
-        double alpha = rsold / ConjugateGradientSolver::dotProduct(p, Ap);
+        double alpha = rzold / ConjugateGradientSolver::dotProduct(p, Ap);
         
         for (int i = 0; i < n; i++) {
             x[i] += alpha * p[i];
@@ -346,20 +879,190 @@ std::vector<double> SparseSolver::sparseCG(const SparseMatrix& A,
             break;
         }
         
-        double beta = rsnew / rsold;
+        double rznew = rsnew;
+        if (M) {
+            M->apply(r, z);
+            rznew = ConjugateGradientSolver::dotProduct(r, z);
+        }
+        
+        double beta = rznew / rzold;
+        const std::vector<double>& s = M ? z : r;
         for (int i = 0; i < n; i++) {
-            p[i] = r[i] + beta * p[i];
+            p[i] = s[i] + beta * p[i];
         }
         
-        rsold = rsnew;
+        rzold = rznew;
     }
     
+    if (iterations) *iterations = std::min(iter + 1, maxIter);
+    
     return x;
 }
 
+std::vector<std::vector<double>> SparseSolver::batchedCG(const LinearOperator& A,
+                                                         const Preconditioner* M,
+                                                         const std::vector<std::vector<double>>& B,
+                                                         bool verbose,
+                                                         std::vector<int>* iterations) {
+    int n = A.size();
+    int k = B.size();
+    size_t nk = (size_t)n * k;
+    
+    // Interleaved blocks of the m active columns: entry i of slot s at i * m + s,
+    // slot s holding right-hand side cols[s]
+    int m = k;
+    std::vector<int> cols(k);
+    for (int j = 0; j < k; j++) cols[j] = j;
+    std::vector<double> X(nk, 0.0), R(nk), Z(nk), P(nk), AP(nk);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < k; j++) R[(size_t)i * k + j] = B[j][i];
+    }
+    std::vector<std::vector<double>> solutions(k, std::vector<double>(n, 0.0));
+    
+    // Column-wise preconditioner application (Z = R without one)
+    std::vector<double> r(n), z(n);
+    auto precondition = [&]() {
+        if (!M) {
+            Z = R;
+            return;
+        }
+        for (int s = 0; s < m; s++) {
+            for (int i = 0; i < n; i++) r[i] = R[(size_t)i * m + s];
+            M->apply(r, z);
+            for (int i = 0; i < n; i++) Z[(size_t)i * m + s] = z[i];
+        }
+    };
+    
+    // Per-slot dot products of two blocks
+    auto columnDots = [&](const std::vector<double>& U, const std::vector<double>& V, std::vector<double>& dots) {
+        std::fill(dots.begin(), dots.begin() + m, 0.0);
+        for (int i = 0; i < n; i++) {
+            for (int s = 0; s < m; s++) dots[s] += U[(size_t)i * m + s] * V[(size_t)i * m + s];
+        }
+    };
+    
+    double tolerance = 1e-8;
+    int maxIter = 10000;
+    std::vector<int> count(k, maxIter);
+    std::vector<double> rz(k), rznew(k), pAp(k), rr(k), alpha(k), beta(k);
+    
+    // Copy out the solutions of converged slots and shrink every block to the
+    // remaining ones, so later products and preconditioner calls skip them
+    auto deflate = [&](int iterCount) {
+        std::vector<int> keep;
+        for (int s = 0; s < m; s++) {
+            if (sqrt(rr[s]) < tolerance) {
+                count[cols[s]] = iterCount;
+                for (int i = 0; i < n; i++) solutions[cols[s]][i] = X[(size_t)i * m + s];
+            } else {
+                keep.push_back(s);
+            }
+        }
+        int kept = keep.size();
+        if (kept == m) return;
+        
+        // In place: the new position i * kept + t never exceeds the old one i * m + keep[t]
+        for (auto* U : {&X, &R, &P}) {
+            for (int i = 0; i < n; i++) {
+                for (int t = 0; t < kept; t++) (*U)[(size_t)i * kept + t] = (*U)[(size_t)i * m + keep[t]];
+            }
+            U->resize((size_t)n * kept);
+        }
+        Z.resize((size_t)n * kept);
+        AP.resize((size_t)n * kept);
+        for (int t = 0; t < kept; t++) {
+            cols[t] = cols[keep[t]];
+            rz[t] = rz[keep[t]];
+        }
+        m = kept;
+    };
+    
+    // Columns that start converged (e.g. zero loads) never divide by p.Ap = 0
+    columnDots(R, R, rr);
+    deflate(0);
+    
+    precondition();
+    P = Z;
+    columnDots(R, Z, rz);
+    
+    if (verbose) {
+        std::cout << "Right-hand sides: " << k << ", block product on " << A.getName() << std::endl;
+    }
+    
+    int iter = 0;
+    for (; iter < maxIter && m > 0; iter++) {
+        A.applyBlock(P, AP, m);
+        columnDots(P, AP, pAp);
+        
+        for (int s = 0; s < m; s++) alpha[s] = rz[s] / pAp[s];
+        for (int i = 0; i < n; i++) {
+            for (int s = 0; s < m; s++) {
+                X[(size_t)i * m + s] += alpha[s] * P[(size_t)i * m + s];
+                R[(size_t)i * m + s] -= alpha[s] * AP[(size_t)i * m + s];
+            }
+        }
+        
+        columnDots(R, R, rr);
+        if (verbose && iter % 100 == 0) {
+            double worst = 0.0;
+            for (int s = 0; s < m; s++) worst = std::max(worst, sqrt(rr[s]));
+            std::cout << "Iteration " << iter << ", Max residual: " << worst
+                      << ", active columns: " << m << std::endl;
+        }
+        
+        deflate(iter + 1);
+        if (m == 0) break;
+        
+        precondition();
+        columnDots(R, Z, rznew);
+        for (int s = 0; s < m; s++) {
+            beta[s] = rznew[s] / rz[s];
+            rz[s] = rznew[s];
+        }
+        for (int i = 0; i < n; i++) {
+            for (int s = 0; s < m; s++) {
+                P[(size_t)i * m + s] = Z[(size_t)i * m + s] + beta[s] * P[(size_t)i * m + s];
+            }
+        }
+    }
+    
+    if (verbose) {
+        std::cout << "All columns converged after " << std::min(iter + 1, maxIter)
+                  << " block iterations" << std::endl;
+    }
+    
+    // Columns still active at maxIter
+    for (int s = 0; s < m; s++) {
+        for (int i = 0; i < n; i++) solutions[cols[s]][i] = X[(size_t)i * m + s];
+    }
+    
+    if (iterations) *iterations = count;
+    
+    return solutions;
+}
+
+// ============== OPERATORS ==============
+
+void DenseOperator::apply(const std::vector<double>& x, std::vector<double>& y) const {
+    ConjugateGradientSolver::matrixVectorMultiply(A, x, y);
+}
+
+void CSROperator::apply(const std::vector<double>& x, std::vector<double>& y) const {
+    SparseSolver::sparseMatVecMult(A, x, y);
+}
+
+void CSROperator::applyBlock(const std::vector<double>& X, std::vector<double>& Y, int k) const {
+    SparseSolver::sparseMatMultiVec(A, X, Y, k);
+}
+
+double CSROperator::memoryBytes() const {
+    return (double)A.values.size() * (sizeof(double) + sizeof(int)) +
+           (double)A.rowPointers.size() * sizeof(int);
+}
+
 // ============== GAUSS-SEIDEL ==============
 
-std::vector<double> GaussSeidelSolver::solve(std::vector<std::vector<double>>& K, 
+std::vector<double> GaussSeidelSolver::solve(DenseMatrix& K, 
                                               std::vector<double>& F,
                                               bool verbose,
                                               double tolerance,
@@ -372,32 +1075,29 @@ std::vector<double> GaussSeidelSolver::solve(std::vector<std::vector<double>>& K
     }
     
     std::vector<double> x(n, 0.0);
-    std::vector<double> x_old(n);
     
     for (int iter = 0; iter < maxIterations; iter++) {
-        x_old = x;
-        
+        // In place: x[j] for j > i still holds the previous iterate, and the size of
+        // each update is accumulated for the convergence check
+        double error = 0.0;
         for (int i = 0; i < n; i++) {
+            const double* Ki = K[i];
             double sum = F[i];
             
             for (int j = 0; j < i; j++) {
-                sum -= K[i][j] * x[j];
+                sum -= Ki[j] * x[j];
             }
             
             for (int j = i + 1; j < n; j++) {
-                sum -= K[i][j] * x_old[j];
+                sum -= Ki[j] * x[j];
             }
             
-            if (std::abs(K[i][i]) > 1e-15) {
-                x[i] = sum / K[i][i];
+            if (std::abs(Ki[i]) > 1e-15) {
+                double xi = sum / Ki[i];
+                error += (xi - x[i]) * (xi - x[i]);
+                x[i] = xi;
             }
         }
-        
-        // Check convergence
-        double error = 0.0;
-        for (int i = 0; i < n; i++) {
-            error += (x[i] - x_old[i]) * (x[i] - x_old[i]);
-        }
         error = sqrt(error);
         
         if (verbose && iter % 100 == 0) {
@@ -3,18 +3,30 @@
 
 #include <vector>
 #include <string>
+#include "../matrix/dense_matrix.h"
+#include "../matrix/dense_kernels.h"
+#include "../matrix/csr_matrix.h"
+#include "linear_operator.h"
+#include "preconditioner.h"
+#include "factorization.h"
 
 // LU Decomposition Solver
 class LUSolver {
 public:
-    static std::vector<double> solve(std::vector<std::vector<double>>& K, 
+    static std::vector<double> solve(DenseMatrix& K, 
                                      std::vector<double>& F,
                                      bool verbose = false);
     
-    static void decompose(std::vector<std::vector<double>>& A, 
-                         std::vector<int>& permutation);
+    // Blocked right-looking LU with partial pivoting: unblocked panel factorization,
+    // triangular solve for the U block row, GEMM update of the trailing matrix
+    static void decompose(DenseMatrix& A, 
+                         std::vector<int>& permutation,
+                         const DenseKernels::Tiling& tiling = DenseKernels::defaultTiling());
     
-    static std::vector<double> solveLU(const std::vector<std::vector<double>>& LU,
+    // Textbook elimination, one rank-1 update of the trailing matrix per column
+    static void decomposeUnblocked(DenseMatrix& A, std::vector<int>& permutation);
+    
+    static std::vector<double> solveLU(const DenseMatrix& LU,
                                        const std::vector<int>& perm,
                                        const std::vector<double>& b);
     
@@ -24,28 +36,72 @@ public:
 // Cholesky Decomposition Solver
 class CholeskySolver {
 public:
-    static std::vector<double> solve(std::vector<std::vector<double>>& K, 
+    static std::vector<double> solve(DenseMatrix& K, 
                                      std::vector<double>& F,
                                      bool verbose = false);
     
-    static bool decompose(std::vector<std::vector<double>>& A);
+    // Blocked right-looking Cholesky: diagonal block, triangular solve for the panel
+    // below it, GEMM update of the trailing lower triangle
+    static bool decompose(DenseMatrix& A,
+                          const DenseKernels::Tiling& tiling = DenseKernels::defaultTiling());
+    
+    // Dot-product (Cholesky-Crout) form on a square block, in place
+    static bool decomposeUnblocked(DenseMatrix::View A);
     
-    static std::vector<double> solveCholesky(const std::vector<std::vector<double>>& L,
+    static std::vector<double> solveCholesky(const DenseMatrix& L,
                                             const std::vector<double>& b);
     
     static std::string getName() { return "Cholesky Decomposition"; }
 };
 
+// Dense LU factors with partial pivoting, reusable across load vectors
+class LUFactorization : public Factorization {
+public:
+    // Copies and factors K; false on a zero pivot. More than one thread runs the
+    // tiled task-parallel factorization.
+    bool factorize(const DenseMatrix& K, int numThreads = 1);
+    
+    std::vector<double> solve(const std::vector<double>& b) const override;
+    double memoryBytes() const override;
+    std::string getName() const override { return LUSolver::getName(); }
+
+private:
+    DenseMatrix LU;
+    std::vector<int> perm;
+};
+
+// Dense Cholesky factor L (K = L L^T), reusable across load vectors
+class CholeskyFactorization : public Factorization {
+public:
+    // Copies and factors K; false if K is not positive definite. More than one
+    // thread runs the tiled task-parallel factorization.
+    bool factorize(const DenseMatrix& K, int numThreads = 1);
+    
+    std::vector<double> solve(const std::vector<double>& b) const override;
+    double memoryBytes() const override;
+    std::string getName() const override { return CholeskySolver::getName(); }
+
+private:
+    DenseMatrix L;
+};
+
 // Conjugate Gradient Solver
 class ConjugateGradientSolver {
 public:
-    static std::vector<double> solve(std::vector<std::vector<double>>& K, 
+    static std::vector<double> solve(DenseMatrix& K, 
                                      std::vector<double>& F,
                                      bool verbose = false,
                                      double tolerance = 1e-8,
                                      int maxIterations = 10000);
     
-    static void matrixVectorMultiply(const std::vector<std::vector<double>>& A,
+    // CG on any operator (dense, CSR, matrix-free)
+    static std::vector<double> solve(const LinearOperator& A, 
+                                     const std::vector<double>& F,
+                                     bool verbose = false,
+                                     double tolerance = 1e-8,
+                                     int maxIterations = 10000);
+    
+    static void matrixVectorMultiply(const DenseMatrix& A,
                                     const std::vector<double>& x,
                                     std::vector<double>& result);
     
@@ -57,34 +113,143 @@ public:
 // Sparse Matrix Solver (using Compressed Row Storage)
 class SparseSolver {
 public:
-    struct SparseMatrix {
-        std::vector<double> values;
-        std::vector<int> colIndices;
-        std::vector<int> rowPointers;
-        int n;
-    };
-    
-    static std::vector<double> solve(std::vector<std::vector<double>>& K, 
+    using SparseMatrix = CSRMatrix;
+    
+    // Storage used for the matrix-vector products of sparseCG (the _FLOAT formats
+    // round values to float32 and use 16-bit relative column indices where they fit)
+    enum class SpMVFormat { CSR, BSR, SELL, CSR_FLOAT, BSR_FLOAT };
+    
+    static std::vector<double> solve(DenseMatrix& K, 
                                      std::vector<double>& F,
                                      bool verbose = false);
     
-    static SparseMatrix convertToSparse(const std::vector<std::vector<double>>& K,
+    // Solve with a matrix that was assembled directly in CSR form
+    static std::vector<double> solve(const SparseMatrix& K, 
+                                     const std::vector<double>& F,
+                                     bool verbose = false,
+                                     int* iterations = nullptr);
+    
+    static SparseMatrix convertToSparse(const DenseMatrix& K,
                                        double threshold = 1e-12);
     
     static void sparseMatVecMult(const SparseMatrix& A, const std::vector<double>& x,
                                 std::vector<double>& result);
     
+    // Row boundaries part[0..parts] splitting A into ranges of about nnz / parts
+    // entries each, so short Dirichlet rows do not leave a thread with less work
+    static std::vector<int> balancedRowPartition(const SparseMatrix& A, int parts);
+    
+    // sparseMatVecMult with range t of the partition on thread t
+    static void parallelMatVecMult(const SparseMatrix& A, const std::vector<double>& x,
+                                   std::vector<double>& result, const std::vector<int>& partition);
+    
+    // Y = A * X for k interleaved vectors (entry i of vector j at i * k + j);
+    // each matrix entry is loaded once and used k times
+    static void sparseMatMultiVec(const SparseMatrix& A, const std::vector<double>& X,
+                                  std::vector<double>& Y, int k);
+    
+    // C = A * B for rectangular CSR matrices (numCols is the column count of B)
+    static SparseMatrix multiply(const SparseMatrix& A, const SparseMatrix& B, int numCols);
+    
+    // A^T of an n x numCols CSR matrix
+    static SparseMatrix transpose(const SparseMatrix& A, int numCols);
+    
+    // CG on a CSR matrix; other formats convert A once and run the products in that format
     static std::vector<double> sparseCG(const SparseMatrix& A, 
                                        const std::vector<double>& b,
-                                       bool verbose = false);
+                                       bool verbose = false,
+                                       int* iterations = nullptr,
+                                       SpMVFormat format = SpMVFormat::CSR);
+    
+    // Sparse CG loop on any operator
+    static std::vector<double> sparseCG(const LinearOperator& A, 
+                                       const std::vector<double>& b,
+                                       bool verbose = false,
+                                       int* iterations = nullptr);
+    
+    // sparseCG on numThreads threads kept alive for the whole solve: every thread owns
+    // an nnz-balanced row range for SpMV, axpys and dot-product partial sums, and
+    // threads only meet at the three barriers of each iteration. Partial sums are
+    // added in thread order, so every thread takes the same convergence decision.
+    static std::vector<double> parallelCG(const SparseMatrix& A,
+                                          const std::vector<double>& b,
+                                          int numThreads,
+                                          bool verbose = false,
+                                          int* iterations = nullptr,
+                                          int maxIterations = 10000);
+    
+    // Pipelined CG (Ghysels-Vanroose) on the same thread layout as parallelCG. The
+    // recurrences for s = A p, z = A s and w = A r let both dot products of an
+    // iteration be taken together, and the next product A w only needs w, so one
+    // barrier per iteration covers the reduction and the product. The extra
+    // recurrences drift from the true residual; every replacementInterval
+    // iterations (0 disables) r, w, s and z are recomputed from x and p.
+    static std::vector<double> pipelinedCG(const SparseMatrix& A,
+                                           const std::vector<double>& b,
+                                           int numThreads,
+                                           bool verbose = false,
+                                           int* iterations = nullptr,
+                                           int replacementInterval = 50,
+                                           int maxIterations = 10000);
+    
+    // Preconditioned CG (M = nullptr gives plain CG); stops on the absolute
+    // residual |r| < 1e-8 like sparseCG, iterations receives the count
+    static std::vector<double> preconditionedCG(const LinearOperator& A,
+                                                const Preconditioner* M,
+                                                const std::vector<double>& b,
+                                                bool verbose = false,
+                                                int* iterations = nullptr);
+    
+    // CG on several right-hand sides at once: one recurrence per column, advanced
+    // in lockstep so every iteration does a single block product A * P. Converged
+    // columns are removed from the blocks, so the product and the preconditioner
+    // only run on the active ones; iterations (if given) receives each count.
+    static std::vector<std::vector<double>> batchedCG(const LinearOperator& A,
+                                                      const Preconditioner* M,
+                                                      const std::vector<std::vector<double>>& B,
+                                                      bool verbose = false,
+                                                      std::vector<int>* iterations = nullptr);
+    
+    // Work arrays of batchedCG for k columns of length n: the n x k blocks X, R, Z, P
+    // and AP plus the r and z columns handed to the preconditioner
+    static double batchedCGWorkspaceBytes(int n, int k) { return (5.0 * k + 2.0) * n * sizeof(double); }
     
     static std::string getName() { return "Sparse Matrix CG"; }
 };
 
+// Dense matrix as a linear operator
+class DenseOperator : public LinearOperator {
+public:
+    explicit DenseOperator(const DenseMatrix& A) : A(A) {}
+    
+    int size() const override { return A.rows(); }
+    void apply(const std::vector<double>& x, std::vector<double>& y) const override;
+    double memoryBytes() const override { return A.memoryBytes(); }
+    std::string getName() const override { return "Dense"; }
+
+private:
+    const DenseMatrix& A;
+};
+
+// CSR matrix as a linear operator
+class CSROperator : public LinearOperator {
+public:
+    explicit CSROperator(const SparseSolver::SparseMatrix& A) : A(A) {}
+    
+    int size() const override { return A.n; }
+    void apply(const std::vector<double>& x, std::vector<double>& y) const override;
+    void applyBlock(const std::vector<double>& X, std::vector<double>& Y, int k) const override;
+    double memoryBytes() const override;
+    std::string getName() const override { return "CSR"; }
+
+private:
+    const SparseSolver::SparseMatrix& A;
+};
+
 // Gauss-Seidel Iterative Solver
 class GaussSeidelSolver {
 public:
-    static std::vector<double> solve(std::vector<std::vector<double>>& K, 
+    static std::vector<double> solve(DenseMatrix& K, 
                                      std::vector<double>& F,
                                      bool verbose = false,
                                      double tolerance = 1e-8,
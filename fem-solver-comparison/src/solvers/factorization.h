@@ -0,0 +1,30 @@
+#ifndef FACTORIZATION_H
+#define FACTORIZATION_H
+
+#include <vector>
+#include <string>
+
+// A matrix factorization kept for reuse across right-hand sides. Subclasses add
+// a factorize() for their matrix format; solve() then only does the triangular
+// solves, so extra load cases on the same mesh cost O(nnz(L)) each.
+class Factorization {
+public:
+    Factorization() : factored(false) {}
+    virtual ~Factorization() {}
+    
+    // Solution of K x = b with the stored factors
+    virtual std::vector<double> solve(const std::vector<double>& b) const = 0;
+    
+    // Storage held by the factors, in bytes
+    virtual double memoryBytes() const = 0;
+    
+    virtual std::string getName() const = 0;
+    
+    // False until factorize() has succeeded
+    bool isFactored() const { return factored; }
+    
+protected:
+    bool factored;
+};
+
+#endif
@@ -0,0 +1,143 @@
+#include "float32_storage.h"
+#include <limits>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// True if every column in colIndices lies within int16 range of its (block) row
+static bool offsetsFit(const std::vector<int>& colIndices, const std::vector<int>& rowPointers, int numRows) {
+    for (int i = 0; i < numRows; i++) {
+        for (int k = rowPointers[i]; k < rowPointers[i + 1]; k++) {
+            int offset = colIndices[k] - i;
+            if (offset < std::numeric_limits<int16_t>::min() || offset > std::numeric_limits<int16_t>::max()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Store columns as int16 offsets from their row, clearing the full indices
+static void shortenIndices(std::vector<int>& colIndices, std::vector<int16_t>& colOffsets,
+                           const std::vector<int>& rowPointers, int numRows) {
+    colOffsets.resize(colIndices.size());
+    for (int i = 0; i < numRows; i++) {
+        for (int k = rowPointers[i]; k < rowPointers[i + 1]; k++) {
+            colOffsets[k] = colIndices[k] - i;
+        }
+    }
+    colIndices.clear();
+    colIndices.shrink_to_fit();
+}
+
+Float32Solver::CSRMatrix Float32Solver::fromCSR(const SparseSolver::SparseMatrix& A, bool shortIndices) {
+    CSRMatrix S;
+    S.n = A.n;
+    S.values.assign(A.values.begin(), A.values.end());
+    S.colIndices = A.colIndices;
+    S.rowPointers = A.rowPointers;
+    S.shortIndices = shortIndices && offsetsFit(A.colIndices, A.rowPointers, A.n);
+    if (S.shortIndices) shortenIndices(S.colIndices, S.colOffsets, S.rowPointers, S.n);
+    return S;
+}
+
+Float32Solver::BSRMatrix Float32Solver::fromBSR(const BSRSolver::BSRMatrix& A, bool shortIndices) {
+    BSRMatrix S;
+    S.numBlockRows = A.numBlockRows;
+    S.values.assign(A.values.begin(), A.values.end());
+    S.colIndices = A.colIndices;
+    S.rowPointers = A.rowPointers;
+    S.shortIndices = shortIndices && offsetsFit(A.colIndices, A.rowPointers, A.numBlockRows);
+    if (S.shortIndices) shortenIndices(S.colIndices, S.colOffsets, S.rowPointers, S.numBlockRows);
+    return S;
+}
+
+void Float32Solver::multiply(const CSRMatrix& A, const std::vector<double>& x, std::vector<double>& y) {
+    const float* v = A.values.data();
+    
+    if (A.shortIndices) {
+        const int16_t* off = A.colOffsets.data();
+        for (int i = 0; i < A.n; i++) {
+            const double* xi = &x[i];
+            double sum = 0.0;
+            for (int k = A.rowPointers[i]; k < A.rowPointers[i + 1]; k++) {
+                sum += (double)v[k] * xi[off[k]];
+            }
+            y[i] = sum;
+        }
+        return;
+    }
+    
+    const int* col = A.colIndices.data();
+    for (int i = 0; i < A.n; i++) {
+        double sum = 0.0;
+        for (int k = A.rowPointers[i]; k < A.rowPointers[i + 1]; k++) {
+            sum += (double)v[k] * x[col[k]];
+        }
+        y[i] = sum;
+    }
+}
+
+void Float32Solver::multiply(const BSRMatrix& A, const std::vector<double>& x, std::vector<double>& y) {
+    const float* v = A.values.data();
+    const int BLOCK = BSRSolver::BLOCK;
+    
+    for (int I = 0; I < A.numBlockRows; I++) {
+        // x of block column k; short indices are relative to this block row
+        auto xBlock = [&](int k) {
+            int J = A.shortIndices ? I + A.colOffsets[k] : A.colIndices[k];
+            return &x[BLOCK * J];
+        };
+#if defined(__SSE2__)
+        // Widen the four floats of a block to its two double columns, then as in BSRSolver
+        __m128d acc = _mm_setzero_pd();
+        for (int k = A.rowPointers[I]; k < A.rowPointers[I + 1]; k++) {
+            const double* xj = xBlock(k);
+            __m128 block = _mm_loadu_ps(v + 4 * k);
+            __m128d c0 = _mm_cvtps_pd(block);
+            __m128d c1 = _mm_cvtps_pd(_mm_movehl_ps(block, block));
+#if defined(__FMA__)
+            acc = _mm_fmadd_pd(c0, _mm_set1_pd(xj[0]), acc);
+            acc = _mm_fmadd_pd(c1, _mm_set1_pd(xj[1]), acc);
+#else
+            acc = _mm_add_pd(acc, _mm_mul_pd(c0, _mm_set1_pd(xj[0])));
+            acc = _mm_add_pd(acc, _mm_mul_pd(c1, _mm_set1_pd(xj[1])));
+#endif
+        }
+        _mm_storeu_pd(&y[BLOCK * I], acc);
+#else
+        double y0 = 0.0, y1 = 0.0;
+        for (int k = A.rowPointers[I]; k < A.rowPointers[I + 1]; k++) {
+            const float* b = v + 4 * k;
+            const double* xj = xBlock(k);
+            y0 += (double)b[0] * xj[0] + (double)b[2] * xj[1];
+            y1 += (double)b[1] * xj[0] + (double)b[3] * xj[1];
+        }
+        y[BLOCK * I] = y0;
+        y[BLOCK * I + 1] = y1;
+#endif
+    }
+}
+
+double Float32Solver::memoryBytes(const CSRMatrix& A) {
+    return (double)A.values.size() * sizeof(float) +
+           (double)A.colIndices.size() * sizeof(int) +
+           (double)A.colOffsets.size() * sizeof(int16_t) +
+           (double)A.rowPointers.size() * sizeof(int);
+}
+
+double Float32Solver::memoryBytes(const BSRMatrix& A) {
+    return (double)A.values.size() * sizeof(float) +
+           (double)A.colIndices.size() * sizeof(int) +
+           (double)A.colOffsets.size() * sizeof(int16_t) +
+           (double)A.rowPointers.size() * sizeof(int);
+}
+
+void CSR32Operator::apply(const std::vector<double>& x, std::vector<double>& y) const {
+    Float32Solver::multiply(A, x, y);
+}
+
+void BSR32Operator::apply(const std::vector<double>& x, std::vector<double>& y) const {
+    Float32Solver::multiply(A, x, y);
+}
@@ -0,0 +1,85 @@
+#ifndef FLOAT32_STORAGE_H
+#define FLOAT32_STORAGE_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "efficient_solver.h"
+#include "bsr_solver.h"
+#include "linear_operator.h"
+
+// CSR and 2x2 BSR with values rounded to float32. SpMV is bound by the matrix
+// stream, so halving the value bytes (and, with short indices, the index bytes)
+// cuts its time; x, y and every product are kept in double. Short indices store
+// each column relative to its row as int16, which holds for any matrix whose
+// (block) bandwidth is below 32768 -- RCM-ordered plates are far inside that.
+// CG then solves the rounded system exactly, so the error against the double K
+// grows with its condition number (see the float32 study before relying on it).
+class Float32Solver {
+public:
+    // Scalar CSR; column of entry k in row i is colIndices[k], or i + colOffsets[k]
+    // when shortIndices is set (colIndices is then empty)
+    struct CSRMatrix {
+        std::vector<float> values;
+        std::vector<int> colIndices;
+        std::vector<int16_t> colOffsets;
+        std::vector<int> rowPointers;
+        int n;
+        bool shortIndices;
+    };
+    
+    // 2x2 blocks in BSRSolver's layout (a00, a10, a01, a11), block columns as above
+    struct BSRMatrix {
+        std::vector<float> values;
+        std::vector<int> colIndices;
+        std::vector<int16_t> colOffsets;
+        std::vector<int> rowPointers;
+        int numBlockRows;
+        bool shortIndices;
+    };
+    
+    // Round values to float; short indices are used only if every offset fits
+    static CSRMatrix fromCSR(const SparseSolver::SparseMatrix& A, bool shortIndices = false);
+    static BSRMatrix fromBSR(const BSRSolver::BSRMatrix& A, bool shortIndices = false);
+    
+    // y = A * x, accumulated in double
+    static void multiply(const CSRMatrix& A, const std::vector<double>& x, std::vector<double>& y);
+    static void multiply(const BSRMatrix& A, const std::vector<double>& x, std::vector<double>& y);
+    
+    // Storage of values, indices and row pointers in bytes
+    static double memoryBytes(const CSRMatrix& A);
+    static double memoryBytes(const BSRMatrix& A);
+    
+    static std::string getName(const CSRMatrix& A) { return A.shortIndices ? "CSR fp32/i16" : "CSR fp32"; }
+    static std::string getName(const BSRMatrix& A) { return A.shortIndices ? "BSR fp32/i16" : "BSR fp32"; }
+};
+
+// Float32 CSR matrix as a linear operator
+class CSR32Operator : public LinearOperator {
+public:
+    explicit CSR32Operator(const Float32Solver::CSRMatrix& A) : A(A) {}
+    
+    int size() const override { return A.n; }
+    void apply(const std::vector<double>& x, std::vector<double>& y) const override;
+    double memoryBytes() const override { return Float32Solver::memoryBytes(A); }
+    std::string getName() const override { return Float32Solver::getName(A); }
+
+private:
+    const Float32Solver::CSRMatrix& A;
+};
+
+// Float32 BSR matrix as a linear operator
+class BSR32Operator : public LinearOperator {
+public:
+    explicit BSR32Operator(const Float32Solver::BSRMatrix& A) : A(A) {}
+    
+    int size() const override { return BSRSolver::BLOCK * A.numBlockRows; }
+    void apply(const std::vector<double>& x, std::vector<double>& y) const override;
+    double memoryBytes() const override { return Float32Solver::memoryBytes(A); }
+    std::string getName() const override { return Float32Solver::getName(A); }
+
+private:
+    const Float32Solver::BSRMatrix& A;
+};
+
+#endif
@@ -0,0 +1,103 @@
+#include "geometric_multigrid.h"
+
+GeometricMultigrid::GeometricMultigrid(const StiffnessMatrix& mesh, const SparseSolver::SparseMatrix& A,
+                                       const std::vector<int>& fixedDOFs, int smoothingSteps,
+                                       int maxCoarseDOFs)
+    : Multigrid(A, smoothingSteps) {
+    int nx = mesh.getNx();
+    int ny = mesh.getNy();
+    
+    // Lattice-to-node map of the fine mesh (coarse levels are numbered by lattice)
+    std::vector<int> fineNode((nx + 1) * (ny + 1));
+    for (int j = 0; j <= ny; j++) {
+        for (int i = 0; i <= nx; i++) {
+            fineNode[j * (nx + 1) + i] = mesh.latticeNode(i, j);
+        }
+    }
+    
+    std::vector<char> fixed(A.n, 0);
+    for (int dof : fixedDOFs) fixed[dof] = 1;
+    
+    gridNx.push_back(nx);
+    gridNy.push_back(ny);
+    
+    while (nx % 2 == 0 && ny % 2 == 0 && 2 * (nx + 1) * (ny + 1) > maxCoarseDOFs) {
+        int cnx = nx / 2, cny = ny / 2;
+        int coarseDOF = 2 * (cnx + 1) * (cny + 1);
+        
+        // A coarse DOF is fixed when its coincident fine DOF is
+        std::vector<char> coarseFixed(coarseDOF);
+        for (int J = 0; J <= cny; J++) {
+            for (int I = 0; I <= cnx; I++) {
+                int node = fineNode[2 * J * (nx + 1) + 2 * I];
+                for (int d = 0; d < 2; d++) {
+                    coarseFixed[2 * (J * (cnx + 1) + I) + d] = fixed[2 * node + d];
+                }
+            }
+        }
+        
+        addCoarseLevel(prolongation(nx, ny, fineNode, fixed, coarseFixed), coarseDOF);
+        
+        nx = cnx;
+        ny = cny;
+        fineNode.resize((nx + 1) * (ny + 1));
+        for (int p = 0; p < (int)fineNode.size(); p++) fineNode[p] = p;
+        fixed = coarseFixed;
+        
+        gridNx.push_back(nx);
+        gridNy.push_back(ny);
+    }
+    
+    finalizeSetup();
+}
+
+SparseSolver::SparseMatrix GeometricMultigrid::prolongation(int nx, int ny, const std::vector<int>& fineNode,
+                                                            const std::vector<char>& fineFixed,
+                                                            const std::vector<char>& coarseFixed) {
+    int cnx = nx / 2;
+    
+    std::vector<int> latticeOf(fineNode.size());
+    for (int p = 0; p < (int)fineNode.size(); p++) latticeOf[fineNode[p]] = p;
+    
+    SparseSolver::SparseMatrix P;
+    P.n = 2 * (nx + 1) * (ny + 1);
+    P.rowPointers.assign(P.n + 1, 0);
+    
+    for (int row = 0; row < P.n; row++) {
+        int d = row % 2;
+        int i = latticeOf[row / 2] % (nx + 1);
+        int j = latticeOf[row / 2] / (nx + 1);
+        
+        // Even lattice indices coincide with a coarse point, odd ones lie midway
+        int I[2], J[2], numI, numJ;
+        double w = 1.0;
+        if (i % 2 == 0) { I[0] = i / 2; numI = 1; }
+        else { I[0] = (i - 1) / 2; I[1] = I[0] + 1; numI = 2; w *= 0.5; }
+        if (j % 2 == 0) { J[0] = j / 2; numJ = 1; }
+        else { J[0] = (j - 1) / 2; J[1] = J[0] + 1; numJ = 2; w *= 0.5; }
+        
+        if (fineFixed[row]) {
+            // Injection onto the coincident (equally fixed) coarse DOF
+            if (numI == 1 && numJ == 1) {
+                P.colIndices.push_back(2 * (J[0] * (cnx + 1) + I[0]) + d);
+                P.values.push_back(1.0);
+            }
+        } else {
+            for (int b = 0; b < numJ; b++) {
+                for (int a = 0; a < numI; a++) {
+                    int col = 2 * (J[b] * (cnx + 1) + I[a]) + d;
+                    if (coarseFixed[col]) continue;
+                    P.colIndices.push_back(col);
+                    P.values.push_back(w);
+                }
+            }
+        }
+        P.rowPointers[row + 1] = P.colIndices.size();
+    }
+    
+    return P;
+}
+
+std::string GeometricMultigrid::levelDescription(int level) const {
+    return std::to_string(gridNx[level]) + " x " + std::to_string(gridNy[level]) + " elements, ";
+}
@@ -0,0 +1,34 @@
+#ifndef GEOMETRIC_MULTIGRID_H
+#define GEOMETRIC_MULTIGRID_H
+
+#include <vector>
+#include <string>
+#include "multigrid.h"
+#include "../matrix/stiffness_matrix.h"
+
+// Geometric multigrid on the structured nx x ny hierarchy. Each coarsening halves
+// nx and ny and bilinear prolongation maps corrections from the coarse lattice.
+class GeometricMultigrid : public Multigrid {
+public:
+    // Coarsening stops when nx or ny is odd or the level has at most maxCoarseDOFs
+    GeometricMultigrid(const StiffnessMatrix& mesh, const SparseSolver::SparseMatrix& A,
+                       const std::vector<int>& fixedDOFs, int smoothingSteps = 2,
+                       int maxCoarseDOFs = 2000);
+    
+    std::string getName() const override { return "Geometric MG"; }
+
+protected:
+    std::string levelDescription(int level) const override;
+
+private:
+    std::vector<int> gridNx, gridNy;  // Elements per direction on each level
+    
+    // Bilinear interpolation from the (nx/2) x (ny/2) lattice. fineNode maps lattice
+    // points to node IDs. Fixed fine DOFs only take their coincident coarse DOF, and
+    // free fine DOFs ignore fixed coarse DOFs, so boundary values are never corrected.
+    static SparseSolver::SparseMatrix prolongation(int nx, int ny, const std::vector<int>& fineNode,
+                                                   const std::vector<char>& fineFixed,
+                                                   const std::vector<char>& coarseFixed);
+};
+
+#endif
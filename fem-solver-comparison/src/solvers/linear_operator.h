@@ -0,0 +1,38 @@
+#ifndef LINEAR_OPERATOR_H
+#define LINEAR_OPERATOR_H
+
+#include <vector>
+#include <string>
+
+// Abstract square operator y = A * x used by the iterative solvers, so the
+// same CG loop runs on dense, CSR or matrix-free representations of K
+class LinearOperator {
+public:
+    virtual ~LinearOperator() {}
+    
+    // Number of rows (= columns)
+    virtual int size() const = 0;
+    
+    // y = A * x (y is pre-sized by the caller)
+    virtual void apply(const std::vector<double>& x, std::vector<double>& y) const = 0;
+    
+    // Y = A * X for k vectors stored interleaved (entry i of vector j at i * k + j).
+    // The default applies the columns one at a time; operators that can stream
+    // their data once for all k vectors override it.
+    virtual void applyBlock(const std::vector<double>& X, std::vector<double>& Y, int k) const {
+        int n = size();
+        std::vector<double> x(n), y(n);
+        for (int j = 0; j < k; j++) {
+            for (int i = 0; i < n; i++) x[i] = X[(size_t)i * k + j];
+            apply(x, y);
+            for (int i = 0; i < n; i++) Y[(size_t)i * k + j] = y[i];
+        }
+    }
+    
+    // Storage held by the operator itself, in bytes
+    virtual double memoryBytes() const = 0;
+    
+    virtual std::string getName() const = 0;
+};
+
+#endif
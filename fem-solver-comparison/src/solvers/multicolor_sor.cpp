@@ -0,0 +1,134 @@
+#include "multicolor_sor.h"
+#include <iostream>
+#include <cmath>
+#include <omp.h>
+
+std::vector<int> MulticolorSOR::colorRows(const SparseSolver::SparseMatrix& A, int& numColors) {
+    std::vector<int> color(A.n, -1);
+    std::vector<int> usedBy;  // usedBy[c] == i if a neighbour of row i has color c
+    numColors = 0;
+    
+    for (int i = 0; i < A.n; i++) {
+        for (int k = A.rowPointers[i]; k < A.rowPointers[i + 1]; k++) {
+            int c = color[A.colIndices[k]];
+            if (c >= 0) usedBy[c] = i;
+        }
+        
+        int c = 0;
+        while (c < numColors && usedBy[c] == i) c++;
+        if (c == numColors) {
+            numColors++;
+            usedBy.push_back(-1);
+        }
+        color[i] = c;
+    }
+    
+    return color;
+}
+
+MulticolorSOR::MulticolorSOR(const SparseSolver::SparseMatrix& A, double omega, int numThreads)
+    : A(A), omega(omega), numThreads(numThreads) {
+    // Bucket rows by color, keeping row order inside a color
+    int numColors = 0;
+    std::vector<int> color = colorRows(A, numColors);
+    colorStart.assign(numColors + 1, 0);
+    for (int i = 0; i < A.n; i++) colorStart[color[i] + 1]++;
+    for (int c = 0; c < numColors; c++) colorStart[c + 1] += colorStart[c];
+    
+    rows.resize(A.n);
+    std::vector<int> next(colorStart.begin(), colorStart.end() - 1);
+    for (int i = 0; i < A.n; i++) rows[next[color[i]]++] = i;
+    
+    // Split every row into its diagonal and the off-diagonal entries, in color order
+    invDiag.assign(A.n, 1.0);
+    offPointers.assign(A.n + 1, 0);
+    offValues.reserve(A.values.size());
+    offColumns.reserve(A.values.size());
+    for (int s = 0; s < A.n; s++) {
+        int i = rows[s];
+        for (int k = A.rowPointers[i]; k < A.rowPointers[i + 1]; k++) {
+            if (A.colIndices[k] != i) {
+                offValues.push_back(A.values[k]);
+                offColumns.push_back(A.colIndices[k]);
+            } else if (A.values[k] != 0.0) {
+                invDiag[s] = 1.0 / A.values[k];
+            }
+        }
+        offPointers[s + 1] = offValues.size();
+    }
+}
+
+void MulticolorSOR::sweep(const std::vector<double>& b, std::vector<double>& x, bool forward) const {
+    int numColors = getNumColors();
+    
+    #pragma omp parallel num_threads(numThreads)
+    for (int step = 0; step < numColors; step++) {
+        int c = forward ? step : numColors - 1 - step;
+        
+        // Rows of one color only read rows of other colors
+        #pragma omp for schedule(static)
+        for (int s = colorStart[c]; s < colorStart[c + 1]; s++) {
+            int i = rows[s];
+            double sum = b[i];
+            for (int k = offPointers[s]; k < offPointers[s + 1]; k++) {
+                sum -= offValues[k] * x[offColumns[k]];
+            }
+            x[i] += omega * (invDiag[s] * sum - x[i]);
+        }
+    }
+}
+
+void MulticolorSOR::apply(const std::vector<double>& r, std::vector<double>& z) const {
+    z.assign(A.n, 0.0);
+    sweep(r, z, true);
+    sweep(r, z, false);
+}
+
+std::vector<double> MulticolorSOR::solve(const std::vector<double>& b, bool verbose, int* iterations,
+                                         double tolerance, int maxIterations) const {
+    int n = A.n;
+    const int checkInterval = 10;
+    std::vector<double> x(n, 0.0), Ax(n);
+    
+    if (verbose) {
+        std::cout << "\n=== MULTICOLOR SOR ===" << std::endl;
+        std::cout << "System size: " << n << ", colors: " << getNumColors() << ", omega: " << omega
+                  << ", threads: " << numThreads << std::endl;
+    }
+    
+    int iter = 0;
+    double residual = 0.0;
+    for (; iter < maxIterations; iter++) {
+        sweep(b, x, true);
+        
+        if ((iter + 1) % checkInterval != 0 && iter + 1 < maxIterations) continue;
+        
+        SparseSolver::sparseMatVecMult(A, x, Ax);
+        residual = 0.0;
+        for (int i = 0; i < n; i++) residual += (b[i] - Ax[i]) * (b[i] - Ax[i]);
+        residual = std::sqrt(residual);
+        
+        if (verbose && (iter + 1) % 1000 == 0) {
+            std::cout << "Iteration " << iter + 1 << ", Residual: " << residual << std::endl;
+        }
+        
+        if (residual < tolerance) {
+            iter++;
+            break;
+        }
+    }
+    
+    if (verbose) {
+        if (residual < tolerance) std::cout << "Converged at iteration " << iter << std::endl;
+        else std::cout << "Warning: SOR did not converge in " << maxIterations << " sweeps" << std::endl;
+    }
+    
+    if (iterations) *iterations = iter;
+    
+    return x;
+}
+
+double MulticolorSOR::memoryBytes() const {
+    return (double)(offValues.size() + invDiag.size()) * sizeof(double) +
+           (double)(offColumns.size() + offPointers.size() + rows.size() + colorStart.size()) * sizeof(int);
+}
@@ -0,0 +1,227 @@
+#include "multigrid.h"
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <algorithm>
+
+Multigrid::Multigrid(const SparseSolver::SparseMatrix& A, int smoothingSteps)
+    : fineA(A), levels(1), smoothingSteps(smoothingSteps) {
+}
+
+void Multigrid::addCoarseLevel(const SparseSolver::SparseMatrix& P, int coarseDOF) {
+    Level& fine = levels.back();
+    fine.P = P;
+    fine.R = SparseSolver::transpose(P, coarseDOF);
+    
+    auto AP = SparseSolver::multiply(matrix(levels.size() - 1), P, coarseDOF);
+    auto Ac = SparseSolver::multiply(fine.R, AP, coarseDOF);
+    
+    // Rows without a diagonal belong to coarse DOFs outside the range of P
+    bool complete = true;
+    for (int i = 0; i < Ac.n && complete; i++) {
+        auto begin = Ac.colIndices.begin() + Ac.rowPointers[i];
+        auto end = Ac.colIndices.begin() + Ac.rowPointers[i + 1];
+        complete = std::binary_search(begin, end, i);
+    }
+    
+    if (!complete) {
+        SparseSolver::SparseMatrix B;
+        B.n = Ac.n;
+        B.rowPointers.assign(Ac.n + 1, 0);
+        for (int i = 0; i < Ac.n; i++) {
+            bool hasDiagonal = false;
+            for (int k = Ac.rowPointers[i]; k < Ac.rowPointers[i + 1]; k++) {
+                if (!hasDiagonal && Ac.colIndices[k] > i) {
+                    B.colIndices.push_back(i);
+                    B.values.push_back(1.0);
+                    hasDiagonal = true;
+                }
+                hasDiagonal = hasDiagonal || Ac.colIndices[k] == i;
+                B.colIndices.push_back(Ac.colIndices[k]);
+                B.values.push_back(Ac.values[k]);
+            }
+            if (!hasDiagonal) {
+                B.colIndices.push_back(i);
+                B.values.push_back(1.0);
+            }
+            B.rowPointers[i + 1] = B.colIndices.size();
+        }
+        Ac = std::move(B);
+    }
+    
+    coarseA.push_back(std::move(Ac));
+    levels.push_back(Level());
+}
+
+void Multigrid::finalizeSetup() {
+    for (int l = 0; l < (int)levels.size(); l++) {
+        const auto& Al = matrix(l);
+        Level& L = levels[l];
+        L.diagPos.assign(Al.n, -1);
+        L.invDiag.assign(Al.n, 1.0);
+        for (int i = 0; i < Al.n; i++) {
+            for (int k = Al.rowPointers[i]; k < Al.rowPointers[i + 1]; k++) {
+                if (Al.colIndices[k] == i && Al.values[k] != 0.0) {
+                    L.diagPos[i] = k;
+                    L.invDiag[i] = 1.0 / Al.values[k];
+                }
+            }
+        }
+        L.x.assign(Al.n, 0.0);
+        L.b.assign(Al.n, 0.0);
+        L.r.assign(Al.n, 0.0);
+    }
+    
+    const auto& Ac = matrix(levels.size() - 1);
+    if (!coarseSolver.factorize(Ac)) {
+        std::cerr << "Error: coarsest multigrid operator is not positive definite" << std::endl;
+    }
+}
+
+void Multigrid::setMulticolorSmoother(int numThreads) {
+    // The coarsest level is solved directly
+    for (int l = 0; l + 1 < (int)levels.size(); l++) {
+        levels[l].multicolor = std::make_unique<MulticolorSOR>(matrix(l), 1.0, numThreads);
+    }
+}
+
+void Multigrid::smooth(int level, bool forward) const {
+    const auto& A = matrix(level);
+    const Level& L = levels[level];
+    int n = A.n;
+    
+    if (L.multicolor) {
+        L.multicolor->sweep(L.b, L.x, forward);
+        return;
+    }
+    
+    for (int s = 0; s < n; s++) {
+        int i = forward ? s : n - 1 - s;
+        double sum = L.b[i];
+        for (int k = A.rowPointers[i]; k < A.rowPointers[i + 1]; k++) {
+            if (k != L.diagPos[i]) sum -= A.values[k] * L.x[A.colIndices[k]];
+        }
+        L.x[i] = L.invDiag[i] * sum;
+    }
+}
+
+void Multigrid::vcycle(int level) const {
+    const Level& L = levels[level];
+    
+    if (level == (int)levels.size() - 1) {
+        L.x = coarseSolver.solve(L.b);
+        return;
+    }
+    
+    const auto& A = matrix(level);
+    const Level& coarse = levels[level + 1];
+    
+    std::fill(L.x.begin(), L.x.end(), 0.0);
+    for (int s = 0; s < smoothingSteps; s++) smooth(level, true);
+    
+    // Restrict the residual, solve the coarse correction and prolongate it
+    SparseSolver::sparseMatVecMult(A, L.x, L.r);
+    for (int i = 0; i < A.n; i++) L.r[i] = L.b[i] - L.r[i];
+    SparseSolver::sparseMatVecMult(L.R, L.r, coarse.b);
+    
+    vcycle(level + 1);
+    
+    SparseSolver::sparseMatVecMult(L.P, coarse.x, L.r);
+    for (int i = 0; i < A.n; i++) L.x[i] += L.r[i];
+    
+    for (int s = 0; s < smoothingSteps; s++) smooth(level, false);
+}
+
+void Multigrid::apply(const std::vector<double>& r, std::vector<double>& z) const {
+    levels[0].b = r;
+    vcycle(0);
+    z = levels[0].x;
+}
+
+std::vector<double> Multigrid::solve(const std::vector<double>& F, bool verbose,
+                                     int* iterations) const {
+    int n = fineA.n;
+    std::vector<double> x(n, 0.0);
+    std::vector<double> r = F;
+    std::vector<double> z(n), Ax(n);
+    double tolerance = 1e-8;
+    int maxIter = 200;
+    
+    if (verbose) {
+        std::cout << "\n=== MULTIGRID V-CYCLES (" << getName() << ") ===" << std::endl;
+        printHierarchy();
+    }
+    
+    double initialResidual = sqrt(ConjugateGradientSolver::dotProduct(r, r));
+    double residual = initialResidual;
+    int iter = 0;
+    
+    for (; iter < maxIter && residual >= tolerance; iter++) {
+        apply(r, z);
+        for (int i = 0; i < n; i++) x[i] += z[i];
+        
+        SparseSolver::sparseMatVecMult(fineA, x, Ax);
+        for (int i = 0; i < n; i++) r[i] = F[i] - Ax[i];
+        residual = sqrt(ConjugateGradientSolver::dotProduct(r, r));
+        
+        if (verbose) {
+            std::cout << "V-cycle " << iter + 1 << ", Residual: " << residual << std::endl;
+        }
+    }
+    
+    if (verbose) {
+        if (residual < tolerance) {
+            std::streamsize precision = std::cout.precision();
+            std::cout << "Converged after " << iter << " V-cycles, average reduction factor "
+                      << std::fixed << std::setprecision(3)
+                      << pow(residual / initialResidual, 1.0 / std::max(iter, 1)) << std::endl;
+            std::cout << std::defaultfloat << std::setprecision(precision);
+        } else {
+            std::cout << "Warning: multigrid did not converge in " << maxIter << " V-cycles" << std::endl;
+        }
+    }
+    
+    if (iterations) *iterations = iter;
+    
+    return x;
+}
+
+double Multigrid::memoryBytes() const {
+    auto csrBytes = [](const SparseSolver::SparseMatrix& M) {
+        return (double)M.values.size() * (sizeof(double) + sizeof(int)) +
+               (double)M.rowPointers.size() * sizeof(int);
+    };
+    
+    // The fine matrix is referenced and counted by the caller
+    double bytes = 0.0;
+    for (const auto& Ac : coarseA) bytes += csrBytes(Ac);
+    for (const auto& L : levels) {
+        bytes += csrBytes(L.P) + csrBytes(L.R);
+        bytes += L.invDiag.size() * (sizeof(double) + sizeof(int));
+        bytes += (L.x.size() + L.b.size() + L.r.size()) * sizeof(double);
+        if (L.multicolor) bytes += L.multicolor->memoryBytes();
+    }
+    bytes += coarseSolver.memoryBytes();
+    
+    return bytes;
+}
+
+double Multigrid::operatorComplexity() const {
+    double nnz = fineA.values.size();
+    for (const auto& Ac : coarseA) nnz += Ac.values.size();
+    return nnz / fineA.values.size();
+}
+
+void Multigrid::printHierarchy() const {
+    for (int l = 0; l < (int)levels.size(); l++) {
+        const auto& A = matrix(l);
+        std::cout << "Level " << l << ": " << levelDescription(l) << A.n << " DOFs, "
+                  << A.values.size() << " nonzeros"
+                  << (l == (int)levels.size() - 1 ? " (direct solve)" : "") << std::endl;
+    }
+    std::streamsize precision = std::cout.precision();
+    std::cout << "Operator complexity: " << std::fixed << std::setprecision(3)
+              << operatorComplexity() << std::defaultfloat << std::setprecision(precision) << std::endl;
+    std::cout << "Smoother: symmetric " << (levels[0].multicolor ? "multicolor " : "") << "Gauss-Seidel, "
+              << smoothingSteps << " pre- and post-smoothing sweeps" << std::endl;
+}
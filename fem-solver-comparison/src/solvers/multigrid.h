@@ -0,0 +1,81 @@
+#ifndef MULTIGRID_H
+#define MULTIGRID_H
+
+#include <vector>
+#include <string>
+#include "preconditioner.h"
+#include "efficient_solver.h"
+#include "supernodal_cholesky.h"
+#include "multicolor_sor.h"
+#include <memory>
+
+// V-cycle machinery shared by the multigrid preconditioners. Subclasses build the
+// hierarchy by handing prolongation operators P to addCoarseLevel(), which forms
+// the Galerkin operator P^T A P, and then call finalizeSetup(). A V-cycle uses
+// symmetric Gauss-Seidel smoothing (forward sweeps before, backward sweeps after
+// the coarse correction) and a supernodal Cholesky solve on the coarsest level,
+// so one cycle is a symmetric positive definite preconditioner for CG.
+class Multigrid : public Preconditioner {
+public:
+    // One V-cycle from a zero initial guess
+    void apply(const std::vector<double>& r, std::vector<double>& z) const override;
+    double memoryBytes() const override;
+    
+    // Stationary V-cycle iteration to the CG tolerance
+    std::vector<double> solve(const std::vector<double>& F, bool verbose = false,
+                              int* iterations = nullptr) const;
+    
+    int getNumLevels() const { return levels.size(); }
+    
+    // Smooth with multicolor Gauss-Seidel (rows of a color in parallel) instead of
+    // sweeps in row order; call after the hierarchy is built
+    void setMulticolorSmoother(int numThreads);
+    
+    // Nonzeros over all levels relative to the fine matrix
+    double operatorComplexity() const;
+    
+    void printHierarchy() const;
+
+protected:
+    // A is the fine CSR matrix with Dirichlet rows applied (referenced, not copied)
+    Multigrid(const SparseSolver::SparseMatrix& A, int smoothingSteps);
+    
+    const SparseSolver::SparseMatrix& matrix(int level) const {
+        return level == 0 ? fineA : coarseA[level - 1];
+    }
+    
+    // Append P^T A P below the current coarsest level. Coarse DOFs that P never
+    // reaches get an identity row so the coarse operator stays nonsingular.
+    void addCoarseLevel(const SparseSolver::SparseMatrix& P, int coarseDOF);
+    
+    // Smoother diagonals, work vectors and the coarsest factorization
+    void finalizeSetup();
+    
+    // Extra text for a level in printHierarchy()
+    virtual std::string levelDescription(int) const { return ""; }
+
+private:
+    struct Level {
+        SparseSolver::SparseMatrix P;   // Prolongation from the next coarser level
+        SparseSolver::SparseMatrix R;   // Restriction P^T
+        std::vector<int> diagPos;
+        std::vector<double> invDiag;
+        std::unique_ptr<MulticolorSOR> multicolor;  // Set by setMulticolorSmoother
+        mutable std::vector<double> x, b, r;
+    };
+    
+    const SparseSolver::SparseMatrix& fineA;
+    std::vector<SparseSolver::SparseMatrix> coarseA;  // Galerkin operators of levels 1, 2, ...
+    std::vector<Level> levels;
+    int smoothingSteps;
+    
+    // Coarsest level factor
+    SupernodalCholeskyFactorization coarseSolver;
+    
+    void vcycle(int level) const;
+    
+    // Gauss-Seidel sweep on a level, forward or backward in row (or color) order
+    void smooth(int level, bool forward) const;
+};
+
+#endif
@@ -4,7 +4,7 @@
 #include <iomanip>
 #include <algorithm>
 
-std::vector<double> NaiveGaussSolver::solve(std::vector<std::vector<double>>& K, 
+std::vector<double> NaiveGaussSolver::solve(DenseMatrix& K, 
                                              std::vector<double>& F,
                                              bool verbose) {
     int n = F.size();
@@ -15,7 +15,7 @@ std::vector<double> NaiveGaussSolver::solve(std::vector<std::vector<double>>& K,
     }
     
     // Make copies to avoid modifying original
-    std::vector<std::vector<double>> A = K;
+    DenseMatrix A = K;
     std::vector<double> b = F;
     
     // Forward elimination
@@ -31,7 +31,7 @@ std::vector<double> NaiveGaussSolver::solve(std::vector<std::vector<double>>& K,
     return solution;
 }
 
-void NaiveGaussSolver::forwardElimination(std::vector<std::vector<double>>& A, 
+void NaiveGaussSolver::forwardElimination(DenseMatrix& A, 
                                           std::vector<double>& b) {
     int n = b.size();
     
@@ -49,7 +49,7 @@ void NaiveGaussSolver::forwardElimination(std::vector<std::vector<double>>& A,
         
         // Swap rows if needed (partial pivoting)
         if (maxRow != k) {
-            std::swap(A[k], A[maxRow]);
+            A.swapRows(k, maxRow);
             std::swap(b[k], b[maxRow]);
         }
         
@@ -71,7 +71,7 @@ void NaiveGaussSolver::forwardElimination(std::vector<std::vector<double>>& A,
     }
 }
 
-std::vector<double> NaiveGaussSolver::backSubstitution(std::vector<std::vector<double>>& A, 
+std::vector<double> NaiveGaussSolver::backSubstitution(DenseMatrix& A, 
                                                        std::vector<double>& b) {
     int n = b.size();
     std::vector<double> x(n, 0.0);
@@ -94,9 +94,9 @@ std::vector<double> NaiveGaussSolver::backSubstitution(std::vector<std::vector<d
     return x;
 }
 
-double NaiveGaussSolver::checkConditionNumber(const std::vector<std::vector<double>>& K) {
+double NaiveGaussSolver::checkConditionNumber(const DenseMatrix& K) {
     // Simple estimate: ratio of max to min diagonal elements
-    int n = K.size();
+    int n = K.rows();
     double maxDiag = 0.0, minDiag = 1e100;
     
     for (int i = 0; i < n; i++) {
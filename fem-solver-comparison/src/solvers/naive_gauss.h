@@ -3,24 +3,25 @@
 
 #include <vector>
 #include <string>
+#include "../matrix/dense_matrix.h"
 
 class NaiveGaussSolver {
 public:
     // Solve [K]{U} = {F} using naive Gaussian elimination
-    static std::vector<double> solve(std::vector<std::vector<double>>& K, 
+    static std::vector<double> solve(DenseMatrix& K, 
                                      std::vector<double>& F,
                                      bool verbose = false);
     
     // Forward elimination
-    static void forwardElimination(std::vector<std::vector<double>>& A, 
+    static void forwardElimination(DenseMatrix& A, 
                                    std::vector<double>& b);
     
     // Back substitution
-    static std::vector<double> backSubstitution(std::vector<std::vector<double>>& A, 
+    static std::vector<double> backSubstitution(DenseMatrix& A, 
                                                std::vector<double>& b);
     
     // Check for numerical stability
-    static double checkConditionNumber(const std::vector<std::vector<double>>& K);
+    static double checkConditionNumber(const DenseMatrix& K);
     
     static std::string getName() { return "Naive Gaussian Elimination"; }
 };
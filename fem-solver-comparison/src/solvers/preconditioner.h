@@ -0,0 +1,22 @@
+#ifndef PRECONDITIONER_H
+#define PRECONDITIONER_H
+
+#include <vector>
+#include <string>
+
+// Abstract preconditioner z = M^-1 * r for the preconditioned CG path.
+// M must be symmetric positive definite for CG to apply.
+class Preconditioner {
+public:
+    virtual ~Preconditioner() {}
+    
+    // z = M^-1 * r (z is pre-sized by the caller)
+    virtual void apply(const std::vector<double>& r, std::vector<double>& z) const = 0;
+    
+    // Storage held by the preconditioner, in bytes
+    virtual double memoryBytes() const = 0;
+    
+    virtual std::string getName() const = 0;
+};
+
+#endif
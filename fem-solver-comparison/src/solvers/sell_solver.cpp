@@ -0,0 +1,96 @@
+#include "sell_solver.h"
+#include <algorithm>
+#include <numeric>
+
+SELLSolver::SELLMatrix SELLSolver::fromCSR(const SparseSolver::SparseMatrix& A, int sigma) {
+    SELLMatrix S;
+    S.n = A.n;
+    S.sigma = std::max(C, (sigma + C - 1) / C * C);
+    S.nnz = A.values.size();
+    
+    auto rowLength = [&A](int i) { return A.rowPointers[i + 1] - A.rowPointers[i]; };
+    
+    // Sort by descending length inside each sigma window (stable keeps RCM order among equals)
+    S.rowOrder.resize(A.n);
+    std::iota(S.rowOrder.begin(), S.rowOrder.end(), 0);
+    if (S.sigma > C) {
+        for (int w = 0; w < A.n; w += S.sigma) {
+            std::stable_sort(S.rowOrder.begin() + w, S.rowOrder.begin() + std::min(w + S.sigma, A.n),
+                             [&](int a, int b) { return rowLength(a) > rowLength(b); });
+        }
+    }
+    
+    int numChunks = (A.n + C - 1) / C;
+    S.chunkStart.assign(numChunks + 1, 0);
+    S.chunkLength.assign(numChunks, 0);
+    for (int c = 0; c < numChunks; c++) {
+        int len = 0;
+        for (int r = 0; r < C && c * C + r < A.n; r++) {
+            len = std::max(len, rowLength(S.rowOrder[c * C + r]));
+        }
+        S.chunkLength[c] = len;
+        S.chunkStart[c + 1] = S.chunkStart[c] + len * C;
+    }
+    
+    S.values.assign(S.chunkStart[numChunks], 0.0);
+    S.colIndices.assign(S.chunkStart[numChunks], 0);
+    for (int c = 0; c < numChunks; c++) {
+        for (int r = 0; r < C && c * C + r < A.n; r++) {
+            int i = S.rowOrder[c * C + r];
+            int begin = A.rowPointers[i], len = rowLength(i);
+            int pad = len > 0 ? A.colIndices[begin + len - 1] : 0;
+            
+            for (int j = 0; j < S.chunkLength[c]; j++) {
+                int pos = S.chunkStart[c] + j * C + r;
+                if (j < len) {
+                    S.values[pos] = A.values[begin + j];
+                    S.colIndices[pos] = A.colIndices[begin + j];
+                } else {
+                    S.colIndices[pos] = pad;
+                }
+            }
+        }
+    }
+    
+    return S;
+}
+
+void SELLSolver::multiply(const SELLMatrix& A, const std::vector<double>& x, std::vector<double>& y) {
+    const double* v = A.values.data();
+    const int* col = A.colIndices.data();
+    const double* xp = x.data();
+    int numChunks = A.chunkLength.size();
+    alignas(64) double lanes[C];
+    
+    for (int c = 0; c < numChunks; c++) {
+        // One lane per row; columns of the chunk are contiguous C-wide slices
+        SimdVec acc = SimdVec::broadcast(0.0);
+        int base = A.chunkStart[c];
+        for (int j = 0; j < A.chunkLength[c]; j++) {
+            int k = base + j * C;
+            acc = SimdVec::fmadd(SimdVec::load(v + k), SimdVec::gather(xp, col + k), acc);
+        }
+        acc.store(lanes);
+        
+        int rows = std::min(C, A.n - c * C);
+        const int* order = &A.rowOrder[c * C];
+        for (int r = 0; r < rows; r++) {
+            y[order[r]] = lanes[r];
+        }
+    }
+}
+
+double SELLSolver::paddingOverhead(const SELLMatrix& A) {
+    if (A.nnz == 0) return 0.0;
+    return (double)(A.values.size() - A.nnz) / A.nnz;
+}
+
+double SELLSolver::memoryBytes(const SELLMatrix& A) {
+    return (double)A.values.size() * sizeof(double) +
+           (double)A.colIndices.size() * sizeof(int) +
+           (double)(A.chunkStart.size() + A.chunkLength.size() + A.rowOrder.size()) * sizeof(int);
+}
+
+void SELLOperator::apply(const std::vector<double>& x, std::vector<double>& y) const {
+    SELLSolver::multiply(A, x, y);
+}
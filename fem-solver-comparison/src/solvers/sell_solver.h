@@ -0,0 +1,63 @@
+#ifndef SELL_SOLVER_H
+#define SELL_SOLVER_H
+
+#include <vector>
+#include <string>
+#include "efficient_solver.h"
+#include "linear_operator.h"
+#include "../matrix/simd_vec.h"
+
+// Sliced ELLPACK (SELL-C-sigma). Rows are cut into chunks of C = SIMD_WIDTH rows and
+// each chunk is padded to its longest row and stored column-major, so one SIMD
+// register holds entry j of C consecutive rows and the inner loop runs over chunk
+// columns with full-width loads and a gather of x. Sorting rows by length inside
+// windows of sigma rows puts rows of similar length in the same chunk, which keeps
+// the padding small while leaving x access mostly local.
+class SELLSolver {
+public:
+    static constexpr int C = SIMD_WIDTH;
+    
+    // Entry j of chunk row r of chunk c lives at values[chunkStart[c] + j * C + r],
+    // and chunk row r is matrix row rowOrder[c * C + r]. Padding has value 0 and
+    // repeats a valid column of its row.
+    struct SELLMatrix {
+        std::vector<double> values;
+        std::vector<int> colIndices;
+        std::vector<int> chunkStart;   // numChunks + 1 offsets into values
+        std::vector<int> chunkLength;  // Columns of each chunk (its longest row)
+        std::vector<int> rowOrder;     // Sorted position -> original row
+        int n;
+        int sigma;
+        long long nnz;                 // Stored nonzeros without padding
+    };
+    
+    // Convert CSR; sigma is rounded up to a multiple of C (sigma <= C means no sorting)
+    static SELLMatrix fromCSR(const SparseSolver::SparseMatrix& A, int sigma = 32 * C);
+    
+    // y = A * x
+    static void multiply(const SELLMatrix& A, const std::vector<double>& x, std::vector<double>& y);
+    
+    // Padding as a fraction of the stored nonzeros
+    static double paddingOverhead(const SELLMatrix& A);
+    
+    // Storage of values, indices, chunk data and row order in bytes
+    static double memoryBytes(const SELLMatrix& A);
+    
+    static std::string getName() { return "SELL-" + std::to_string(C) + "-sigma"; }
+};
+
+// SELL matrix as a linear operator
+class SELLOperator : public LinearOperator {
+public:
+    explicit SELLOperator(const SELLSolver::SELLMatrix& A) : A(A) {}
+    
+    int size() const override { return A.n; }
+    void apply(const std::vector<double>& x, std::vector<double>& y) const override;
+    double memoryBytes() const override { return SELLSolver::memoryBytes(A); }
+    std::string getName() const override { return SELLSolver::getName(); }
+
+private:
+    const SELLSolver::SELLMatrix& A;
+};
+
+#endif
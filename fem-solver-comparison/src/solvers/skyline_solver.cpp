@@ -0,0 +1,154 @@
+#include "skyline_solver.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+std::vector<double> SkylineSolver::solve(const SparseSolver::SparseMatrix& K,
+                                         const std::vector<double>& F,
+                                         bool verbose) {
+    int n = F.size();
+    
+    if (verbose) {
+        std::cout << "\n=== SKYLINE LDL^T ===" << std::endl;
+        std::cout << "System size: " << n << " x " << n << std::endl;
+    }
+    
+    SkylineFactorization factors;
+    if (!factors.factorize(K, verbose)) {
+        std::cerr << "Skyline LDL^T factorization failed (matrix not positive definite)" << std::endl;
+        return std::vector<double>(n, 0.0);
+    }
+    
+    auto solution = factors.solve(F);
+    
+    if (verbose) {
+        std::cout << "Solution computed successfully" << std::endl;
+    }
+    
+    return solution;
+}
+
+SkylineSolver::SkylineMatrix SkylineSolver::fromCSR(const SparseSolver::SparseMatrix& K) {
+    SkylineMatrix A;
+    A.n = K.n;
+    A.firstCol.resize(K.n);
+    A.rowStart.assign(K.n + 1, 0);
+    
+    for (int i = 0; i < K.n; i++) {
+        int first = i;
+        for (int k = K.rowPointers[i]; k < K.rowPointers[i + 1]; k++) {
+            first = std::min(first, K.colIndices[k]);
+        }
+        A.firstCol[i] = first;
+        A.rowStart[i + 1] = A.rowStart[i] + (i - first + 1);
+    }
+    
+    A.values.assign(A.rowStart[K.n], 0.0);
+    for (int i = 0; i < K.n; i++) {
+        for (int k = K.rowPointers[i]; k < K.rowPointers[i + 1]; k++) {
+            int j = K.colIndices[k];
+            if (j <= i) A.values[A.rowStart[i] + j - A.firstCol[i]] = K.values[k];
+        }
+    }
+    
+    return A;
+}
+
+bool SkylineSolver::decompose(SkylineMatrix& A) {
+    // Row-oriented Crout: row i first gets u_ij = l_ij * d_j from dot products
+    // with the finished rows above, then is scaled by D^-1
+    for (int i = 0; i < A.n; i++) {
+        int fi = A.firstCol[i];
+        double* rowI = &A.values[A.rowStart[i]];  // rowI[j - fi] = entry (i, j)
+        
+        for (int j = fi + 1; j < i; j++) {
+            int fj = A.firstCol[j];
+            int k0 = std::max(fi, fj);
+            const double* a = rowI + (k0 - fi);
+            const double* b = &A.values[A.rowStart[j]] + (k0 - fj);
+            
+            double sum = 0.0;
+            for (int k = 0; k < j - k0; k++) {
+                sum += a[k] * b[k];
+            }
+            rowI[j - fi] -= sum;
+        }
+        
+        double d = rowI[i - fi];
+        for (int j = fi; j < i; j++) {
+            double u = rowI[j - fi];
+            rowI[j - fi] = u / A.values[A.rowStart[j + 1] - 1];
+            d -= u * rowI[j - fi];
+        }
+        
+        if (d <= 0.0) {
+            return false;  // Not positive definite
+        }
+        rowI[i - fi] = d;
+    }
+    
+    return true;
+}
+
+std::vector<double> SkylineSolver::solveLDLT(const SkylineMatrix& LDL, const std::vector<double>& b) {
+    int n = LDL.n;
+    std::vector<double> x = b;
+    
+    // Forward substitution (Ly = b), one row dot product per row
+    for (int i = 0; i < n; i++) {
+        int fi = LDL.firstCol[i];
+        const double* row = &LDL.values[LDL.rowStart[i]];
+        double sum = 0.0;
+        for (int j = fi; j < i; j++) {
+            sum += row[j - fi] * x[j];
+        }
+        x[i] -= sum;
+    }
+    
+    // Diagonal (Dz = y)
+    for (int i = 0; i < n; i++) {
+        x[i] /= LDL.values[LDL.rowStart[i + 1] - 1];
+    }
+    
+    // Back substitution (L^T x = z), column-wise through the rows
+    for (int i = n - 1; i >= 0; i--) {
+        int fi = LDL.firstCol[i];
+        const double* row = &LDL.values[LDL.rowStart[i]];
+        double xi = x[i];
+        for (int j = fi; j < i; j++) {
+            x[j] -= row[j - fi] * xi;
+        }
+    }
+    
+    return x;
+}
+
+double SkylineSolver::memoryMB(const SkylineMatrix& A) {
+    return (A.values.size() * sizeof(double) + A.rowStart.size() * sizeof(long long) +
+            A.firstCol.size() * sizeof(int)) / (1024.0 * 1024.0);
+}
+
+// ============== REUSABLE FACTORIZATION ==============
+
+bool SkylineFactorization::factorize(const SparseSolver::SparseMatrix& K, bool verbose) {
+    LDL = SkylineSolver::fromCSR(K);
+    
+    if (verbose) {
+        int n = LDL.n;
+        int maxBand = 0;
+        for (int i = 0; i < n; i++) maxBand = std::max(maxBand, i - LDL.firstCol[i]);
+        std::streamsize precision = std::cout.precision();
+        std::cout << "Envelope entries: " << LDL.values.size() << " (mean half-bandwidth "
+                  << std::fixed << std::setprecision(1) << (double)LDL.values.size() / n - 1.0
+                  << ", max " << maxBand << ")" << std::endl;
+        std::cout << "Envelope storage: " << std::setprecision(3) << SkylineSolver::memoryMB(LDL)
+                  << " MB" << std::defaultfloat << std::setprecision(precision) << std::endl;
+    }
+    
+    factored = SkylineSolver::decompose(LDL);
+    return factored;
+}
+
+std::vector<double> SkylineFactorization::solve(const std::vector<double>& b) const {
+    return SkylineSolver::solveLDLT(LDL, b);
+}
@@ -0,0 +1,54 @@
+#ifndef SKYLINE_SOLVER_H
+#define SKYLINE_SOLVER_H
+
+#include <vector>
+#include <string>
+#include "efficient_solver.h"
+#include "factorization.h"
+
+// Skyline (variable-band) LDL^T solver. Only the lower envelope of K is
+// stored, row by row, so factorization costs O(n b^2) and each solve O(n b)
+// for half-bandwidth b. Works best after bandwidth-reducing renumbering.
+class SkylineSolver {
+public:
+    // Row i holds columns firstCol[i]..i; entry (i, j) is at rowStart[i] + j - firstCol[i]
+    struct SkylineMatrix {
+        std::vector<double> values;
+        std::vector<long long> rowStart;  // n + 1 offsets
+        std::vector<int> firstCol;
+        int n;
+    };
+    
+    static std::vector<double> solve(const SparseSolver::SparseMatrix& K,
+                                     const std::vector<double>& F,
+                                     bool verbose = false);
+    
+    // Envelope of the lower triangle of a CSR matrix, filled with its values
+    static SkylineMatrix fromCSR(const SparseSolver::SparseMatrix& K);
+    
+    // In-place LDL^T: strict lower part becomes L, diagonal becomes D
+    static bool decompose(SkylineMatrix& A);
+    
+    static std::vector<double> solveLDLT(const SkylineMatrix& LDL, const std::vector<double>& b);
+    
+    // Storage of the envelope in MB
+    static double memoryMB(const SkylineMatrix& A);
+    
+    static std::string getName() { return "Skyline LDL^T"; }
+};
+
+// Skyline LDL^T factors of a CSR matrix, reusable across load vectors
+class SkylineFactorization : public Factorization {
+public:
+    // Envelope of K, factored in place; false if K is not positive definite
+    bool factorize(const SparseSolver::SparseMatrix& K, bool verbose = false);
+    
+    std::vector<double> solve(const std::vector<double>& b) const override;
+    double memoryBytes() const override { return SkylineSolver::memoryMB(LDL) * 1024.0 * 1024.0; }
+    std::string getName() const override { return SkylineSolver::getName(); }
+    
+private:
+    SkylineSolver::SkylineMatrix LDL;
+};
+
+#endif
@@ -0,0 +1,311 @@
+#include "smoothed_aggregation.h"
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+std::vector<double> SmoothedAggregationAMG::rigidBodyModes(const std::vector<StiffnessMatrix::Node>& nodes) {
+    int n = 2 * nodes.size();
+    std::vector<double> B(3 * n, 0.0);
+    
+    for (const auto& node : nodes) {
+        int u = 2 * node.id, v = u + 1;
+        B[u] = 1.0;                 // Translation in x
+        B[n + v] = 1.0;             // Translation in y
+        B[2 * n + u] = -node.y;     // Rotation about the origin
+        B[2 * n + v] = node.x;
+    }
+    
+    return B;
+}
+
+SmoothedAggregationAMG::SmoothedAggregationAMG(const SparseSolver::SparseMatrix& A,
+                                               const std::vector<StiffnessMatrix::Node>& nodes,
+                                               Options options)
+    : Multigrid(A, options.smoothingSteps) {
+    const int numModes = 3;
+    std::vector<double> B = rigidBodyModes(nodes);
+    int blockSize = 2;
+    
+    if ((int)B.size() != numModes * A.n) {
+        std::cerr << "Error: SA-AMG needs two DOFs per node, got " << A.n << " DOFs for "
+                  << nodes.size() << " nodes" << std::endl;
+        B.clear();
+    }
+    
+    blockSizes.push_back(blockSize);
+    
+    while (!B.empty() && matrix(getNumLevels() - 1).n > options.maxCoarseDOFs &&
+           getNumLevels() < options.maxLevels) {
+        const auto& Al = matrix(getNumLevels() - 1);
+        
+        auto strong = strengthGraph(Al, blockSize, options.strengthThreshold);
+        std::vector<int> aggregateOf;
+        int count = aggregate(strong, aggregateOf);
+        
+        // Stop when aggregation no longer reduces the problem
+        int coarseDOF = count * numModes;
+        if (count == 0 || coarseDOF >= Al.n) break;
+        
+        std::vector<double> coarseB;
+        auto Ptent = tentativeProlongator(aggregateOf, count, blockSize, B, numModes, coarseB);
+        addCoarseLevel(smoothProlongator(Al, Ptent, coarseDOF), coarseDOF);
+        
+        B = coarseB;
+        blockSize = numModes;
+        numAggregates.push_back(count);
+        blockSizes.push_back(blockSize);
+    }
+    numAggregates.push_back(0);
+    
+    finalizeSetup();
+}
+
+std::vector<std::vector<int>> SmoothedAggregationAMG::strengthGraph(const SparseSolver::SparseMatrix& A,
+                                                                    int blockSize, double threshold) {
+    int numBlocks = A.n / blockSize;
+    
+    // Squared Frobenius norms of the blocks in each block row
+    std::vector<double> normSq(numBlocks, 0.0);
+    std::vector<int> marker(numBlocks, -1);
+    std::vector<int> neighbours;
+    std::vector<double> diagonalNorm(numBlocks, 0.0);
+    std::vector<std::vector<std::pair<int, double>>> blockRows(numBlocks);
+    
+    for (int I = 0; I < numBlocks; I++) {
+        neighbours.clear();
+        for (int i = I * blockSize; i < (I + 1) * blockSize; i++) {
+            for (int k = A.rowPointers[i]; k < A.rowPointers[i + 1]; k++) {
+                int J = A.colIndices[k] / blockSize;
+                if (marker[J] != I) {
+                    marker[J] = I;
+                    normSq[J] = 0.0;
+                    neighbours.push_back(J);
+                }
+                normSq[J] += A.values[k] * A.values[k];
+            }
+        }
+        for (int J : neighbours) {
+            if (J == I) diagonalNorm[I] = std::sqrt(normSq[J]);
+            else blockRows[I].push_back({J, std::sqrt(normSq[J])});
+        }
+    }
+    
+    std::vector<std::vector<int>> strong(numBlocks);
+    for (int I = 0; I < numBlocks; I++) {
+        for (const auto& entry : blockRows[I]) {
+            int J = entry.first;
+            if (entry.second >= threshold * std::sqrt(diagonalNorm[I] * diagonalNorm[J])) {
+                strong[I].push_back(J);
+            }
+        }
+        std::sort(strong[I].begin(), strong[I].end());
+    }
+    
+    return strong;
+}
+
+int SmoothedAggregationAMG::aggregate(const std::vector<std::vector<int>>& strong,
+                                      std::vector<int>& aggregateOf) {
+    const int unassigned = -2;
+    int numBlocks = strong.size();
+    int count = 0;
+    
+    aggregateOf.assign(numBlocks, unassigned);
+    for (int i = 0; i < numBlocks; i++) {
+        if (strong[i].empty()) aggregateOf[i] = -1;
+    }
+    
+    // Pass 1: a block whose whole neighbourhood is free seeds an aggregate with it
+    for (int i = 0; i < numBlocks; i++) {
+        if (aggregateOf[i] != unassigned) continue;
+        bool free = true;
+        for (int j : strong[i]) free = free && aggregateOf[j] == unassigned;
+        if (!free) continue;
+        
+        aggregateOf[i] = count;
+        for (int j : strong[i]) aggregateOf[j] = count;
+        count++;
+    }
+    
+    // Pass 2: join the aggregate of a neighbour that was placed in pass 1
+    std::vector<int> seeded = aggregateOf;
+    for (int i = 0; i < numBlocks; i++) {
+        if (aggregateOf[i] != unassigned) continue;
+        for (int j : strong[i]) {
+            if (seeded[j] >= 0) {
+                aggregateOf[i] = seeded[j];
+                break;
+            }
+        }
+    }
+    
+    // Pass 3: group whatever is left with its free neighbours
+    for (int i = 0; i < numBlocks; i++) {
+        if (aggregateOf[i] != unassigned) continue;
+        aggregateOf[i] = count;
+        for (int j : strong[i]) {
+            if (aggregateOf[j] == unassigned) aggregateOf[j] = count;
+        }
+        count++;
+    }
+    
+    return count;
+}
+
+SparseSolver::SparseMatrix SmoothedAggregationAMG::tentativeProlongator(const std::vector<int>& aggregateOf,
+                                                                       int numAggregates, int blockSize,
+                                                                       const std::vector<double>& B, int numModes,
+                                                                       std::vector<double>& coarseB) {
+    int numBlocks = aggregateOf.size();
+    int n = numBlocks * blockSize;
+    int nc = numAggregates * numModes;
+    
+    // Members of each aggregate and the position of every block within its aggregate
+    std::vector<int> start(numAggregates + 1, 0);
+    for (int a : aggregateOf) {
+        if (a >= 0) start[a + 1]++;
+    }
+    for (int a = 0; a < numAggregates; a++) start[a + 1] += start[a];
+    std::vector<int> members(start[numAggregates]);
+    std::vector<int> localIndex(numBlocks, -1);
+    std::vector<int> next(start.begin(), start.end() - 1);
+    for (int i = 0; i < numBlocks; i++) {
+        int a = aggregateOf[i];
+        if (a < 0) continue;
+        localIndex[i] = next[a] - start[a];
+        members[next[a]++] = i;
+    }
+    
+    // Modified Gram-Schmidt on the rows of B in each aggregate: B_a = Q_a R_a.
+    // Q is stored column-major per aggregate, R becomes the coarse near-nullspace.
+    std::vector<long long> qStart(numAggregates + 1, 0);
+    for (int a = 0; a < numAggregates; a++) {
+        qStart[a + 1] = qStart[a] + (long long)(start[a + 1] - start[a]) * blockSize * numModes;
+    }
+    std::vector<double> Q(qStart[numAggregates]);
+    coarseB.assign((size_t)numModes * nc, 0.0);
+    
+    for (int a = 0; a < numAggregates; a++) {
+        int m = (start[a + 1] - start[a]) * blockSize;
+        double* q = &Q[qStart[a]];
+        
+        for (int c = 0; c < numModes; c++) {
+            double* v = q + c * m;
+            for (int p = start[a]; p < start[a + 1]; p++) {
+                for (int d = 0; d < blockSize; d++) {
+                    v[(p - start[a]) * blockSize + d] = B[(size_t)c * n + members[p] * blockSize + d];
+                }
+            }
+            
+            double original = 0.0;
+            for (int r = 0; r < m; r++) original += v[r] * v[r];
+            original = std::sqrt(original);
+            
+            for (int d = 0; d < c; d++) {
+                double dot = 0.0;
+                for (int r = 0; r < m; r++) dot += q[d * m + r] * v[r];
+                for (int r = 0; r < m; r++) v[r] -= dot * q[d * m + r];
+                coarseB[(size_t)c * nc + a * numModes + d] = dot;
+            }
+            
+            double norm = 0.0;
+            for (int r = 0; r < m; r++) norm += v[r] * v[r];
+            norm = std::sqrt(norm);
+            
+            // Modes that are dependent on this aggregate (e.g. too few nodes) are dropped
+            if (norm > 1e-10 * original) {
+                for (int r = 0; r < m; r++) v[r] /= norm;
+                coarseB[(size_t)c * nc + a * numModes + c] = norm;
+            } else {
+                for (int r = 0; r < m; r++) v[r] = 0.0;
+            }
+        }
+    }
+    
+    SparseSolver::SparseMatrix P;
+    P.n = n;
+    P.rowPointers.assign(n + 1, 0);
+    for (int row = 0; row < n; row++) {
+        int block = row / blockSize;
+        int a = aggregateOf[block];
+        if (a >= 0) {
+            int m = (start[a + 1] - start[a]) * blockSize;
+            int r = localIndex[block] * blockSize + row % blockSize;
+            for (int c = 0; c < numModes; c++) {
+                double value = Q[qStart[a] + c * m + r];
+                if (value != 0.0) {
+                    P.colIndices.push_back(a * numModes + c);
+                    P.values.push_back(value);
+                }
+            }
+        }
+        P.rowPointers[row + 1] = P.colIndices.size();
+    }
+    
+    return P;
+}
+
+double SmoothedAggregationAMG::spectralRadiusEstimate(const SparseSolver::SparseMatrix& A,
+                                                      const std::vector<double>& invDiag) {
+    int n = A.n;
+    std::vector<double> v(n), w(n);
+    for (int i = 0; i < n; i++) v[i] = 1.0 + 0.5 * std::sin(i);
+    
+    double rho = 0.0;
+    for (int iter = 0; iter < 15; iter++) {
+        double norm = std::sqrt(ConjugateGradientSolver::dotProduct(v, v));
+        for (int i = 0; i < n; i++) v[i] /= norm;
+        
+        SparseSolver::sparseMatVecMult(A, v, w);
+        for (int i = 0; i < n; i++) w[i] *= invDiag[i];
+        
+        rho = std::sqrt(ConjugateGradientSolver::dotProduct(w, w));
+        std::swap(v, w);
+    }
+    
+    return rho;
+}
+
+SparseSolver::SparseMatrix SmoothedAggregationAMG::smoothProlongator(const SparseSolver::SparseMatrix& A,
+                                                                    const SparseSolver::SparseMatrix& Ptent,
+                                                                    int numCols) {
+    std::vector<double> invDiag(A.n, 1.0);
+    for (int i = 0; i < A.n; i++) {
+        for (int k = A.rowPointers[i]; k < A.rowPointers[i + 1]; k++) {
+            if (A.colIndices[k] == i && A.values[k] != 0.0) invDiag[i] = 1.0 / A.values[k];
+        }
+    }
+    double omega = 4.0 / (3.0 * spectralRadiusEstimate(A, invDiag));
+    
+    auto AP = SparseSolver::multiply(A, Ptent, numCols);
+    
+    // Merge the sorted rows of P_tent and -omega D^-1 A P_tent
+    SparseSolver::SparseMatrix P;
+    P.n = A.n;
+    P.rowPointers.assign(A.n + 1, 0);
+    for (int i = 0; i < A.n; i++) {
+        int kt = Ptent.rowPointers[i], endT = Ptent.rowPointers[i + 1];
+        int ka = AP.rowPointers[i], endA = AP.rowPointers[i + 1];
+        double scale = omega * invDiag[i];
+        
+        while (kt < endT || ka < endA) {
+            int ct = kt < endT ? Ptent.colIndices[kt] : numCols;
+            int ca = ka < endA ? AP.colIndices[ka] : numCols;
+            double value = 0.0;
+            int col = std::min(ct, ca);
+            if (ct == col) value += Ptent.values[kt++];
+            if (ca == col) value -= scale * AP.values[ka++];
+            P.colIndices.push_back(col);
+            P.values.push_back(value);
+        }
+        P.rowPointers[i + 1] = P.colIndices.size();
+    }
+    
+    return P;
+}
+
+std::string SmoothedAggregationAMG::levelDescription(int level) const {
+    std::string text = std::to_string(blockSizes[level]) + "x" + std::to_string(blockSizes[level]) + " blocks, ";
+    if (numAggregates[level] > 0) text += std::to_string(numAggregates[level]) + " aggregates, ";
+    return text;
+}
@@ -0,0 +1,69 @@
+#ifndef SMOOTHED_AGGREGATION_H
+#define SMOOTHED_AGGREGATION_H
+
+#include <vector>
+#include <string>
+#include "multigrid.h"
+#include "../matrix/stiffness_matrix.h"
+
+// Smoothed-aggregation algebraic multigrid. The hierarchy is built from the CSR
+// matrix alone, apart from the rigid-body modes that seed the near-nullspace:
+//  - unknowns are grouped in nodal blocks (2x2 on the fine level, one block per
+//    aggregate of size numModes below) and aggregated by strength of coupling;
+//  - the tentative prolongator holds the near-nullspace, orthonormalized per aggregate;
+//  - one damped Jacobi step smooths it: P = (I - omega D^-1 A) P_tent.
+// Dirichlet nodes (blocks without off-diagonal couplings) stay out of every
+// aggregate and are handled by the smoother alone.
+class SmoothedAggregationAMG : public Multigrid {
+public:
+    struct Options {
+        double strengthThreshold;   // Strong if |A_ij| >= theta sqrt(|A_ii| |A_jj|) (block Frobenius norms)
+        int smoothingSteps;
+        int maxCoarseDOFs;
+        int maxLevels;
+    };
+    
+    static Options defaultOptions() { return {0.08, 2, 2000, 10}; }
+    
+    // Near-nullspace of plane elasticity: translations in x and y and the in-plane
+    // rotation, one column-major block of 2 * numNodes rows per mode
+    static std::vector<double> rigidBodyModes(const std::vector<StiffnessMatrix::Node>& nodes);
+    
+    // A is the fine CSR matrix with Dirichlet rows applied (referenced, not copied)
+    SmoothedAggregationAMG(const SparseSolver::SparseMatrix& A,
+                           const std::vector<StiffnessMatrix::Node>& nodes,
+                           Options options = defaultOptions());
+    
+    std::string getName() const override { return "SA-AMG"; }
+
+protected:
+    std::string levelDescription(int level) const override;
+
+private:
+    std::vector<int> blockSizes;       // Unknowns per nodal block on each level
+    std::vector<int> numAggregates;    // Aggregates formed from each level (0 on the coarsest)
+    
+    // Strongly coupled neighbour blocks of every block (self excluded)
+    static std::vector<std::vector<int>> strengthGraph(const SparseSolver::SparseMatrix& A,
+                                                       int blockSize, double threshold);
+    
+    // Three-pass aggregation (seed aggregates from untouched neighbourhoods, attach
+    // leftovers to a neighbouring aggregate, group the rest); -1 for isolated blocks
+    static int aggregate(const std::vector<std::vector<int>>& strong, std::vector<int>& aggregateOf);
+    
+    // Tentative prolongator and the coarse near-nullspace from a per-aggregate QR of B
+    static SparseSolver::SparseMatrix tentativeProlongator(const std::vector<int>& aggregateOf,
+                                                           int numAggregates, int blockSize,
+                                                           const std::vector<double>& B, int numModes,
+                                                           std::vector<double>& coarseB);
+    
+    // P = P_tent - omega D^-1 A P_tent with omega = 4 / (3 rho(D^-1 A))
+    static SparseSolver::SparseMatrix smoothProlongator(const SparseSolver::SparseMatrix& A,
+                                                        const SparseSolver::SparseMatrix& Ptent,
+                                                        int numCols);
+    
+    // Power-iteration estimate of the spectral radius of D^-1 A
+    static double spectralRadiusEstimate(const SparseSolver::SparseMatrix& A, const std::vector<double>& invDiag);
+};
+
+#endif
@@ -0,0 +1,153 @@
+#include "sparse_preconditioners.h"
+#include <iostream>
+#include <cmath>
+
+// ============== JACOBI ==============
+
+JacobiPreconditioner::JacobiPreconditioner(const SparseSolver::SparseMatrix& A) : invDiag(A.n, 1.0) {
+    for (int i = 0; i < A.n; i++) {
+        for (int k = A.rowPointers[i]; k < A.rowPointers[i + 1]; k++) {
+            if (A.colIndices[k] == i && A.values[k] != 0.0) invDiag[i] = 1.0 / A.values[k];
+        }
+    }
+}
+
+void JacobiPreconditioner::apply(const std::vector<double>& r, std::vector<double>& z) const {
+    int n = invDiag.size();
+    for (int i = 0; i < n; i++) {
+        z[i] = invDiag[i] * r[i];
+    }
+}
+
+// ============== SSOR ==============
+
+SSORPreconditioner::SSORPreconditioner(const SparseSolver::SparseMatrix& A, double omega)
+    : A(A), omega(omega), invDiag(A.n, 1.0), diagPos(A.n, -1) {
+    for (int i = 0; i < A.n; i++) {
+        for (int k = A.rowPointers[i]; k < A.rowPointers[i + 1]; k++) {
+            if (A.colIndices[k] == i) {
+                diagPos[i] = k;
+                invDiag[i] = 1.0 / A.values[k];
+            }
+        }
+    }
+}
+
+void SSORPreconditioner::apply(const std::vector<double>& r, std::vector<double>& z) const {
+    int n = A.n;
+    
+    // Forward sweep: (D/w + L) y = r
+    for (int i = 0; i < n; i++) {
+        double sum = r[i];
+        for (int k = A.rowPointers[i]; k < diagPos[i]; k++) {
+            sum -= A.values[k] * z[A.colIndices[k]];
+        }
+        z[i] = omega * invDiag[i] * sum;
+    }
+    
+    // Backward sweep: (D/w + U) z = (D/w) y, scaled by (2 - w) / w
+    for (int i = n - 1; i >= 0; i--) {
+        double sum = 0.0;
+        for (int k = diagPos[i] + 1; k < A.rowPointers[i + 1]; k++) {
+            sum += A.values[k] * z[A.colIndices[k]];
+        }
+        z[i] -= omega * invDiag[i] * sum;
+    }
+    
+    double scale = (2.0 - omega) / omega;
+    for (int i = 0; i < n; i++) {
+        z[i] *= scale;
+    }
+}
+
+// ============== INCOMPLETE CHOLESKY ==============
+
+IncompleteCholeskyPreconditioner::IncompleteCholeskyPreconditioner(const SparseSolver::SparseMatrix& A)
+    : shift(0.0) {
+    // Lower triangle with sorted columns, so the diagonal ends each row
+    rowPointers.assign(A.n + 1, 0);
+    for (int i = 0; i < A.n; i++) {
+        for (int k = A.rowPointers[i]; k < A.rowPointers[i + 1]; k++) {
+            if (A.colIndices[k] <= i) {
+                colIndices.push_back(A.colIndices[k]);
+                values.push_back(A.values[k]);
+            }
+        }
+        rowPointers[i + 1] = colIndices.size();
+    }
+    
+    std::vector<double> lower = values;
+    double alpha = 0.0;
+    while (!factorize(lower, alpha)) {
+        alpha = (alpha == 0.0) ? 1e-3 : 2.0 * alpha;
+    }
+    shift = alpha;
+    
+    if (shift > 0.0) {
+        std::cout << "IC(0): diagonal shifted by " << shift << " to avoid breakdown" << std::endl;
+    }
+}
+
+bool IncompleteCholeskyPreconditioner::factorize(const std::vector<double>& lower, double alpha) {
+    int n = rowPointers.size() - 1;
+    values = lower;
+    
+    for (int i = 0; i < n; i++) {
+        int rowStart = rowPointers[i];
+        int diag = rowPointers[i + 1] - 1;
+        
+        // L(i, j) = (A(i, j) - sum_k L(i, k) L(j, k)) / L(j, j) over the common pattern k < j
+        for (int p = rowStart; p < diag; p++) {
+            int j = colIndices[p];
+            double sum = values[p];
+            
+            int a = rowStart, b = rowPointers[j];
+            int bEnd = rowPointers[j + 1] - 1;
+            while (a < p && b < bEnd) {
+                if (colIndices[a] == colIndices[b]) sum -= values[a++] * values[b++];
+                else if (colIndices[a] < colIndices[b]) a++;
+                else b++;
+            }
+            values[p] = sum / values[rowPointers[j + 1] - 1];
+        }
+        
+        double d = values[diag] * (1.0 + alpha);
+        for (int p = rowStart; p < diag; p++) {
+            d -= values[p] * values[p];
+        }
+        if (d <= 0.0) {
+            return false;  // Breakdown
+        }
+        values[diag] = std::sqrt(d);
+    }
+    
+    return true;
+}
+
+void IncompleteCholeskyPreconditioner::apply(const std::vector<double>& r, std::vector<double>& z) const {
+    int n = rowPointers.size() - 1;
+    
+    // Forward substitution (L y = r)
+    for (int i = 0; i < n; i++) {
+        double sum = r[i];
+        int diag = rowPointers[i + 1] - 1;
+        for (int p = rowPointers[i]; p < diag; p++) {
+            sum -= values[p] * z[colIndices[p]];
+        }
+        z[i] = sum / values[diag];
+    }
+    
+    // Back substitution (L^T z = y), column-wise through the rows
+    for (int i = n - 1; i >= 0; i--) {
+        int diag = rowPointers[i + 1] - 1;
+        z[i] /= values[diag];
+        double zi = z[i];
+        for (int p = rowPointers[i]; p < diag; p++) {
+            z[colIndices[p]] -= values[p] * zi;
+        }
+    }
+}
+
+double IncompleteCholeskyPreconditioner::memoryBytes() const {
+    return values.size() * (sizeof(double) + sizeof(int)) + rowPointers.size() * sizeof(int);
+}
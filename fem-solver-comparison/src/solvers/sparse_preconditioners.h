@@ -0,0 +1,66 @@
+#ifndef SPARSE_PRECONDITIONERS_H
+#define SPARSE_PRECONDITIONERS_H
+
+#include <vector>
+#include <string>
+#include "preconditioner.h"
+#include "efficient_solver.h"
+
+// Jacobi: M = diag(A)
+class JacobiPreconditioner : public Preconditioner {
+public:
+    explicit JacobiPreconditioner(const SparseSolver::SparseMatrix& A);
+    
+    void apply(const std::vector<double>& r, std::vector<double>& z) const override;
+    double memoryBytes() const override { return invDiag.size() * sizeof(double); }
+    std::string getName() const override { return "Jacobi"; }
+    
+private:
+    std::vector<double> invDiag;
+};
+
+// Symmetric SOR: M = (D/w + L) (D/w)^-1 (D/w + U) * w / (2 - w), applied as a
+// forward and a backward sweep over the CSR rows (w = 1: symmetric Gauss-Seidel)
+class SSORPreconditioner : public Preconditioner {
+public:
+    SSORPreconditioner(const SparseSolver::SparseMatrix& A, double omega = 1.0);
+    
+    void apply(const std::vector<double>& r, std::vector<double>& z) const override;
+    double memoryBytes() const override {
+        return invDiag.size() * sizeof(double) + diagPos.size() * sizeof(int);
+    }
+    std::string getName() const override { return "SSOR"; }
+    
+private:
+    const SparseSolver::SparseMatrix& A;
+    double omega;
+    std::vector<double> invDiag;
+    std::vector<int> diagPos;  // Position of the diagonal in each row (columns are sorted)
+};
+
+// Zero-fill incomplete Cholesky: L L^T ~ A with L restricted to the pattern of
+// tril(A). On breakdown the diagonal is shifted, A + alpha * diag(A), and the
+// factorization retried with doubled alpha.
+class IncompleteCholeskyPreconditioner : public Preconditioner {
+public:
+    explicit IncompleteCholeskyPreconditioner(const SparseSolver::SparseMatrix& A);
+    
+    void apply(const std::vector<double>& r, std::vector<double>& z) const override;
+    double memoryBytes() const override;
+    std::string getName() const override { return "IC(0)"; }
+    
+    // Diagonal shift that was needed (0 if none)
+    double getShift() const { return shift; }
+    
+private:
+    // tril(A) in CSR, diagonal last in every row
+    std::vector<double> values;
+    std::vector<int> colIndices;
+    std::vector<int> rowPointers;
+    double shift;
+    
+    // Factor in place from the original lower values; false on a nonpositive pivot
+    bool factorize(const std::vector<double>& lower, double alpha);
+};
+
+#endif
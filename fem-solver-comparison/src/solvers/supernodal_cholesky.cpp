@@ -0,0 +1,427 @@
+#include "supernodal_cholesky.h"
+#include "../matrix/node_ordering.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+
+std::vector<double> SupernodalCholeskySolver::solve(const SparseSolver::SparseMatrix& K,
+                                                    const std::vector<double>& F,
+                                                    bool verbose) {
+    int n = F.size();
+    
+    if (verbose) {
+        std::cout << "\n=== SUPERNODAL SPARSE CHOLESKY ===" << std::endl;
+        std::cout << "System size: " << n << " x " << n << std::endl;
+    }
+    
+    SupernodalCholeskyFactorization factors;
+    if (!factors.factorize(K, verbose)) {
+        std::cerr << "Supernodal Cholesky factorization failed (matrix not positive definite)" << std::endl;
+        return std::vector<double>(n, 0.0);
+    }
+    
+    auto t0 = std::chrono::high_resolution_clock::now();
+    auto solution = factors.solve(F);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    
+    if (verbose) {
+        std::chrono::duration<double> solveTime = t1 - t0;
+        std::streamsize precision = std::cout.precision();
+        std::cout << "Time: solve " << std::fixed << std::setprecision(6) << solveTime.count()
+                  << " s" << std::defaultfloat << std::setprecision(precision) << std::endl;
+        std::cout << "Solution computed successfully" << std::endl;
+    }
+    
+    return solution;
+}
+
+void SupernodalCholeskySolver::permutedLowerPattern(const SparseSolver::SparseMatrix& K,
+                                                    const std::vector<int>& perm,
+                                                    std::vector<int>& rowPtr,
+                                                    std::vector<int>& colIdx) {
+    int n = K.n;
+    std::vector<int> pinv(n);
+    for (int k = 0; k < n; k++) pinv[perm[k]] = k;
+    
+    rowPtr.assign(n + 1, 0);
+    colIdx.clear();
+    for (int i = 0; i < n; i++) {
+        int row = perm[i];
+        size_t start = colIdx.size();
+        for (int k = K.rowPointers[row]; k < K.rowPointers[row + 1]; k++) {
+            int j = pinv[K.colIndices[k]];
+            if (j < i) colIdx.push_back(j);
+        }
+        std::sort(colIdx.begin() + start, colIdx.end());
+        rowPtr[i + 1] = colIdx.size();
+    }
+}
+
+std::vector<int> SupernodalCholeskySolver::eliminationTree(const std::vector<int>& rowPtr,
+                                                           const std::vector<int>& colIdx) {
+    int n = rowPtr.size() - 1;
+    std::vector<int> parent(n, -1), ancestor(n, -1);
+    
+    for (int i = 0; i < n; i++) {
+        for (int k = rowPtr[i]; k < rowPtr[i + 1]; k++) {
+            // Climb from j to the root of its current subtree, compressing the path to i
+            int j = colIdx[k];
+            while (j != -1 && j < i) {
+                int next = ancestor[j];
+                ancestor[j] = i;
+                if (next == -1) parent[j] = i;
+                j = next;
+            }
+        }
+    }
+    return parent;
+}
+
+std::vector<int> SupernodalCholeskySolver::postorder(const std::vector<int>& parent) {
+    int n = parent.size();
+    std::vector<int> head(n, -1), next(n, -1), post;
+    post.reserve(n);
+    
+    // Children lists in increasing order
+    for (int j = n - 1; j >= 0; j--) {
+        if (parent[j] == -1) continue;
+        next[j] = head[parent[j]];
+        head[parent[j]] = j;
+    }
+    
+    std::vector<int> stack;
+    for (int root = 0; root < n; root++) {
+        if (parent[root] != -1) continue;
+        stack.push_back(root);
+        while (!stack.empty()) {
+            int p = stack.back();
+            int child = head[p];
+            if (child == -1) {
+                stack.pop_back();
+                post.push_back(p);
+            } else {
+                head[p] = next[child];
+                stack.push_back(child);
+            }
+        }
+    }
+    return post;
+}
+
+SupernodalCholeskySolver::Symbolic SupernodalCholeskySolver::analyze(const SparseSolver::SparseMatrix& K,
+                                                                     Ordering ordering) {
+    Symbolic S;
+    int n = K.n;
+    S.n = n;
+    
+    // Fill-reducing ordering, then postorder the elimination tree so that
+    // supernodes are contiguous
+    std::vector<int> perm(n);
+    if (ordering == NESTED_DISSECTION) {
+        perm = NodeOrdering::nestedDissection(NodeOrdering::matrixGraph(K));
+    } else {
+        for (int k = 0; k < n; k++) perm[k] = k;
+    }
+    
+    std::vector<int> rowPtr, colIdx;
+    permutedLowerPattern(K, perm, rowPtr, colIdx);
+    std::vector<int> post = postorder(eliminationTree(rowPtr, colIdx));
+    
+    S.perm.resize(n);
+    for (int k = 0; k < n; k++) S.perm[k] = perm[post[k]];
+    permutedLowerPattern(K, S.perm, rowPtr, colIdx);
+    S.parent = eliminationTree(rowPtr, colIdx);
+    
+    // Column counts of L from the row subtrees: row i of L is the set of
+    // nodes reached climbing the tree from each k with A(i, k) != 0
+    std::vector<int> colCount(n, 1), mark(n, -1);
+    for (int i = 0; i < n; i++) {
+        mark[i] = i;
+        for (int k = rowPtr[i]; k < rowPtr[i + 1]; k++) {
+            for (int j = colIdx[k]; mark[j] != i; j = S.parent[j]) {
+                colCount[j]++;
+                mark[j] = i;
+            }
+        }
+    }
+    
+    // Fundamental supernodes: j + 1 extends j's supernode when it is j's parent,
+    // its only child, and L(:, j) has the same pattern below j
+    std::vector<int> numChildren(n, 0);
+    for (int j = 0; j < n; j++) {
+        if (S.parent[j] != -1) numChildren[S.parent[j]]++;
+    }
+    
+    S.superOf.resize(n);
+    S.superStart.assign(1, 0);
+    for (int j = 0; j < n; j++) {
+        bool extend = j > 0 && S.parent[j - 1] == j && numChildren[j] == 1 &&
+                      colCount[j - 1] == colCount[j] + 1;
+        if (j > 0 && !extend) S.superStart.push_back(j);
+        S.superOf[j] = S.superStart.size() - 1;
+    }
+    S.superStart.push_back(n);
+    int numSuper = S.numSupernodes();
+    
+    // Row structure of each supernode = pattern of its first column
+    S.rowStart.assign(numSuper + 1, 0);
+    for (int s = 0; s < numSuper; s++) {
+        S.rowStart[s + 1] = S.rowStart[s] + colCount[S.superStart[s]];
+    }
+    S.rows.resize(S.rowStart[numSuper]);
+    std::vector<long long> fillPos(S.rowStart.begin(), S.rowStart.end() - 1);
+    
+    std::fill(mark.begin(), mark.end(), -1);
+    for (int i = 0; i < n; i++) {
+        mark[i] = i;
+        if (S.superStart[S.superOf[i]] == i) S.rows[fillPos[S.superOf[i]]++] = i;
+        for (int k = rowPtr[i]; k < rowPtr[i + 1]; k++) {
+            for (int j = colIdx[k]; mark[j] != i; j = S.parent[j]) {
+                mark[j] = i;
+                if (S.superStart[S.superOf[j]] == j) S.rows[fillPos[S.superOf[j]]++] = i;
+            }
+        }
+    }
+    
+    // Panel storage, fill and flop counts
+    S.valueStart.assign(numSuper + 1, 0);
+    S.nnzL = 0;
+    S.flops = 0.0;
+    for (int s = 0; s < numSuper; s++) {
+        long long numRows = S.rowStart[s + 1] - S.rowStart[s];
+        long long numCols = S.superStart[s + 1] - S.superStart[s];
+        S.valueStart[s + 1] = S.valueStart[s] + numRows * numCols;
+    }
+    for (int j = 0; j < n; j++) {
+        S.nnzL += colCount[j];
+        S.flops += (double)colCount[j] * colCount[j];
+    }
+    
+    // Where each lower-triangle entry of K lands in the panels
+    std::vector<int> pinv(n);
+    for (int k = 0; k < n; k++) pinv[S.perm[k]] = k;
+    S.scatterMap.assign(K.values.size(), -1);
+    S.rowPointers = K.rowPointers;
+    S.colIndices = K.colIndices;
+    S.nnzA = 0;
+    for (int r = 0; r < n; r++) {
+        for (int k = K.rowPointers[r]; k < K.rowPointers[r + 1]; k++) {
+            int i = pinv[r];
+            int j = pinv[K.colIndices[k]];
+            if (i < j) continue;
+            
+            int s = S.superOf[j];
+            const int* first = &S.rows[S.rowStart[s]];
+            const int* last = first + (S.rowStart[s + 1] - S.rowStart[s]);
+            long long localRow = std::lower_bound(first, last, i) - first;
+            S.scatterMap[k] = S.valueStart[s] + (j - S.superStart[s]) * (last - first) + localRow;
+            S.nnzA++;
+        }
+    }
+    
+    return S;
+}
+
+bool SupernodalCholeskySolver::factorize(const SparseSolver::SparseMatrix& K, const Symbolic& S,
+                                         std::vector<double>& L) {
+    int numSuper = S.numSupernodes();
+    L.assign(S.valueStart[numSuper], 0.0);
+    
+    for (size_t k = 0; k < K.values.size(); k++) {
+        if (S.scatterMap[k] >= 0) L[S.scatterMap[k]] += K.values[k];
+    }
+    
+    // Descendants waiting to update supernode s form a linked list from head[s];
+    // nextRow[d] is the first row of d not yet applied
+    std::vector<int> head(numSuper, -1), next(numSuper, -1);
+    std::vector<long long> nextRow(numSuper);
+    std::vector<int> rowMap(S.n, -1);
+    std::vector<double> work;
+    
+    for (int s = 0; s < numSuper; s++) {
+        int f = S.superStart[s];
+        int numCols = S.superStart[s + 1] - f;
+        int numRows = S.rowStart[s + 1] - S.rowStart[s];
+        const int* rows = &S.rows[S.rowStart[s]];
+        double* panel = &L[S.valueStart[s]];
+        
+        for (int r = 0; r < numRows; r++) rowMap[rows[r]] = r;
+        
+        // Left-looking updates: L(s rows, s cols) -= L_d(s rows, :) * L_d(s cols, :)^T
+        for (int d = head[s]; d != -1; ) {
+            int nextD = next[d];
+            int dCols = S.superStart[d + 1] - S.superStart[d];
+            int dRows = S.rowStart[d + 1] - S.rowStart[d];
+            const int* drows = &S.rows[S.rowStart[d]];
+            const double* dpanel = &L[S.valueStart[d]];
+            
+            int p1 = nextRow[d];
+            int p2 = p1;
+            while (p2 < dRows && drows[p2] < f + numCols) p2++;
+            
+            int m = dRows - p1;
+            work.assign((size_t)m * (p2 - p1), 0.0);
+            for (int c = p1; c < p2; c++) {
+                double* w = &work[(size_t)(c - p1) * m];
+                for (int k = 0; k < dCols; k++) {
+                    const double* dcol = dpanel + (size_t)k * dRows;
+                    double lck = dcol[c];
+                    for (int r = c; r < dRows; r++) {
+                        w[r - p1] += dcol[r] * lck;
+                    }
+                }
+            }
+            
+            for (int c = p1; c < p2; c++) {
+                double* col = panel + (size_t)(drows[c] - f) * numRows;
+                const double* w = &work[(size_t)(c - p1) * m];
+                for (int r = c; r < dRows; r++) {
+                    col[rowMap[drows[r]]] -= w[r - p1];
+                }
+            }
+            
+            // Pass d on to the supernode of its next row
+            nextRow[d] = p2;
+            if (p2 < dRows) {
+                int t = S.superOf[drows[p2]];
+                next[d] = head[t];
+                head[t] = d;
+            }
+            d = nextD;
+        }
+        
+        // Dense Cholesky of the panel: diagonal block and the rows below it
+        for (int j = 0; j < numCols; j++) {
+            double* colj = panel + (size_t)j * numRows;
+            if (colj[j] <= 0.0) {
+                return false;  // Not positive definite
+            }
+            double djj = std::sqrt(colj[j]);
+            colj[j] = djj;
+            for (int r = j + 1; r < numRows; r++) colj[r] /= djj;
+            
+            for (int k = j + 1; k < numCols; k++) {
+                double* colk = panel + (size_t)k * numRows;
+                double lkj = colj[k];
+                for (int r = k; r < numRows; r++) {
+                    colk[r] -= colj[r] * lkj;
+                }
+            }
+        }
+        
+        // Queue s for the supernode of its first off-diagonal row
+        nextRow[s] = numCols;
+        if (numCols < numRows) {
+            int t = S.superOf[rows[numCols]];
+            next[s] = head[t];
+            head[t] = s;
+        }
+    }
+    
+    return true;
+}
+
+std::vector<double> SupernodalCholeskySolver::solveFactor(const Symbolic& S, const std::vector<double>& L,
+                                                          const std::vector<double>& b) {
+    int n = S.n;
+    int numSuper = S.numSupernodes();
+    std::vector<double> x(n);
+    for (int k = 0; k < n; k++) x[k] = b[S.perm[k]];
+    
+    // Forward substitution (Ly = Pb)
+    for (int s = 0; s < numSuper; s++) {
+        int f = S.superStart[s];
+        int numCols = S.superStart[s + 1] - f;
+        int numRows = S.rowStart[s + 1] - S.rowStart[s];
+        const int* rows = &S.rows[S.rowStart[s]];
+        const double* panel = &L[S.valueStart[s]];
+        
+        for (int j = 0; j < numCols; j++) {
+            const double* col = panel + (size_t)j * numRows;
+            double xj = x[f + j] / col[j];
+            x[f + j] = xj;
+            for (int r = j + 1; r < numRows; r++) {
+                x[rows[r]] -= col[r] * xj;
+            }
+        }
+    }
+    
+    // Back substitution (L^T z = y)
+    for (int s = numSuper - 1; s >= 0; s--) {
+        int f = S.superStart[s];
+        int numCols = S.superStart[s + 1] - f;
+        int numRows = S.rowStart[s + 1] - S.rowStart[s];
+        const int* rows = &S.rows[S.rowStart[s]];
+        const double* panel = &L[S.valueStart[s]];
+        
+        for (int j = numCols - 1; j >= 0; j--) {
+            const double* col = panel + (size_t)j * numRows;
+            double sum = x[f + j];
+            for (int r = j + 1; r < numRows; r++) {
+                sum -= col[r] * x[rows[r]];
+            }
+            x[f + j] = sum / col[j];
+        }
+    }
+    
+    // Undo the permutation
+    std::vector<double> solution(n);
+    for (int k = 0; k < n; k++) solution[S.perm[k]] = x[k];
+    return solution;
+}
+
+double SupernodalCholeskySolver::memoryMB(const Symbolic& S) {
+    return (S.valueStart.back() * sizeof(double) +
+            (S.rows.size() + S.rowPointers.size() + S.colIndices.size()) * sizeof(int) +
+            S.scatterMap.size() * sizeof(long long) +
+            (S.perm.size() + S.parent.size() + S.superOf.size() + S.superStart.size()) * sizeof(int) +
+            (S.rowStart.size() + S.valueStart.size()) * sizeof(long long)) / (1024.0 * 1024.0);
+}
+
+// ============== REUSABLE FACTORIZATION ==============
+
+bool SupernodalCholeskyFactorization::factorize(const SparseSolver::SparseMatrix& K, bool verbose) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    
+    // The scatter map is tied to the exact CSR pattern, so reuse requires the same
+    // row pointers and column indices, not just the same size
+    bool samePattern = analyzed && S.matches(K);
+    if (!samePattern) {
+        S = SupernodalCholeskySolver::analyze(K);
+        analyzed = true;
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    
+    factored = SupernodalCholeskySolver::factorize(K, S, L);
+    auto t2 = std::chrono::high_resolution_clock::now();
+    
+    if (verbose && factored) {
+        int n = K.n;
+        std::chrono::duration<double> analyzeTime = t1 - t0, factorTime = t2 - t1;
+        std::streamsize precision = std::cout.precision();
+        std::cout << "Supernodes: " << S.numSupernodes() << " (mean "
+                  << std::fixed << std::setprecision(1) << (double)n / S.numSupernodes()
+                  << " columns)" << std::endl;
+        std::cout << "nnz(A) lower: " << S.nnzA << ", nnz(L): " << S.nnzL
+                  << " (fill ratio " << std::setprecision(2) << (double)S.nnzL / S.nnzA << ")" << std::endl;
+        std::cout << "Factorization flops: " << std::scientific << std::setprecision(3) << S.flops
+                  << " (" << std::fixed << std::setprecision(2)
+                  << S.flops / factorTime.count() / 1e9 << " GFLOP/s)" << std::endl;
+        std::cout << "Time: analyze " << std::setprecision(6) << analyzeTime.count()
+                  << " s" << (samePattern ? " (reused)" : "")
+                  << ", factorize " << factorTime.count() << " s"
+                  << std::defaultfloat << std::setprecision(precision) << std::endl;
+    }
+    
+    return factored;
+}
+
+std::vector<double> SupernodalCholeskyFactorization::solve(const std::vector<double>& b) const {
+    return SupernodalCholeskySolver::solveFactor(S, L, b);
+}
+
+double SupernodalCholeskyFactorization::memoryBytes() const {
+    return analyzed ? SupernodalCholeskySolver::memoryMB(S) * 1024.0 * 1024.0 : 0.0;
+}
@@ -0,0 +1,107 @@
+#ifndef SUPERNODAL_CHOLESKY_H
+#define SUPERNODAL_CHOLESKY_H
+
+#include <vector>
+#include <string>
+#include "efficient_solver.h"
+#include "factorization.h"
+
+// Sparse supernodal Cholesky for CSR matrices. analyze() does all pattern work
+// (fill-reducing ordering, elimination tree, symbolic factorization) and can be
+// reused for any matrix with the same pattern; factorize() computes L in dense
+// column-major panels, one per supernode, with a left-looking update scheme.
+class SupernodalCholeskySolver {
+public:
+    enum Ordering {
+        NATURAL,
+        NESTED_DISSECTION
+    };
+    
+    struct Symbolic {
+        int n;
+        std::vector<int> perm;            // perm[k] = original index of pivot k
+        std::vector<int> parent;          // Elimination tree (postordered), -1 for roots
+        
+        // Supernode s holds pivots superStart[s]..superStart[s+1]-1; its panel has
+        // the rows rows[rowStart[s]..rowStart[s+1]) and is stored column-major at valueStart[s]
+        std::vector<int> superStart;
+        std::vector<int> superOf;         // Supernode of each pivot
+        std::vector<long long> rowStart;
+        std::vector<int> rows;
+        std::vector<long long> valueStart;
+        
+        // Panel position of each CSR entry in the lower triangle (-1 for the upper)
+        std::vector<long long> scatterMap;
+        
+        // CSR pattern that was analyzed; the scatter map is only valid for this pattern
+        std::vector<int> rowPointers;
+        std::vector<int> colIndices;
+        
+        long long nnzA;                   // Lower triangle of A, diagonal included
+        long long nnzL;                   // Nonzeros of L
+        double flops;                     // Factorization flops, sum of |L(:,j)|^2
+        
+        int numSupernodes() const { return superStart.size() - 1; }
+        
+        // True if K has exactly the analyzed pattern (values may differ)
+        bool matches(const SparseSolver::SparseMatrix& K) const {
+            return K.n == n && K.rowPointers == rowPointers && K.colIndices == colIndices;
+        }
+    };
+    
+    static std::vector<double> solve(const SparseSolver::SparseMatrix& K,
+                                     const std::vector<double>& F,
+                                     bool verbose = false);
+    
+    // Ordering, elimination tree, supernodes and the structure of L
+    static Symbolic analyze(const SparseSolver::SparseMatrix& K,
+                            Ordering ordering = NESTED_DISSECTION);
+    
+    // Numeric factorization into supernodal panels L (sized by the symbolic phase)
+    static bool factorize(const SparseSolver::SparseMatrix& K, const Symbolic& S,
+                          std::vector<double>& L);
+    
+    static std::vector<double> solveFactor(const Symbolic& S, const std::vector<double>& L,
+                                           const std::vector<double>& b);
+    
+    // Storage of the panels and index arrays in MB
+    static double memoryMB(const Symbolic& S);
+    
+    static std::string getName() { return "Supernodal Cholesky"; }
+
+private:
+    // Strictly lower pattern of P A P^T by rows
+    static void permutedLowerPattern(const SparseSolver::SparseMatrix& K, const std::vector<int>& perm,
+                                     std::vector<int>& rowPtr, std::vector<int>& colIdx);
+    
+    // Liu's elimination tree algorithm with path compression
+    static std::vector<int> eliminationTree(const std::vector<int>& rowPtr, const std::vector<int>& colIdx);
+    
+    // Postorder of a forest given by parent pointers
+    static std::vector<int> postorder(const std::vector<int>& parent);
+};
+
+// Supernodal Cholesky factors of a CSR matrix, reusable across load vectors.
+// The symbolic analysis is kept as well, so refactoring a matrix with an identical
+// CSR pattern (same row pointers and column indices) skips the ordering and
+// elimination tree; any other pattern, e.g. after renumbering, is analyzed again.
+class SupernodalCholeskyFactorization : public Factorization {
+public:
+    SupernodalCholeskyFactorization() : analyzed(false) {}
+    
+    // false if K is not positive definite
+    bool factorize(const SparseSolver::SparseMatrix& K, bool verbose = false);
+    
+    std::vector<double> solve(const std::vector<double>& b) const override;
+    double memoryBytes() const override;
+    std::string getName() const override { return SupernodalCholeskySolver::getName(); }
+    
+    const SupernodalCholeskySolver::Symbolic& getSymbolic() const { return S; }
+    
+private:
+    SupernodalCholeskySolver::Symbolic S;
+    std::vector<double> L;
+    bool analyzed;
+};
+
+#endif
@@ -0,0 +1,135 @@
+#include "tiled_dense.h"
+#include "efficient_solver.h"
+#include <omp.h>
+#include <cmath>
+#include <algorithm>
+
+bool TiledDenseSolver::choleskyDecompose(DenseMatrix& A, int numThreads, const DenseKernels::Tiling& tiling) {
+    int n = A.rows();
+    int nb = std::max(1, tiling.panel);
+    int T = (n + nb - 1) / nb;
+    const DenseMatrix& cA = A;
+    bool positiveDefinite = true;
+    
+    // One dependency token per tile; only the addresses matter
+    std::vector<char> tokens((size_t)T * T);
+    [[maybe_unused]] char* tile = tokens.data();
+    auto start = [nb](int t) { return t * nb; };
+    auto size = [nb, n](int t) { return std::min(nb, n - t * nb); };
+    
+    #pragma omp parallel num_threads(numThreads)
+    #pragma omp single
+    for (int k = 0; k < T; k++) {
+        // POTRF: factor the diagonal tile
+        #pragma omp task depend(inout: tile[k * T + k])
+        {
+            if (!CholeskySolver::decomposeUnblocked(A.block(start(k), start(k), size(k), size(k)))) {
+                #pragma omp atomic write
+                positiveDefinite = false;
+            }
+        }
+        
+        // TRSM: tiles below it, L_ik = A_ik L_kk^-T
+        for (int i = k + 1; i < T; i++) {
+            #pragma omp task depend(in: tile[k * T + k]) depend(inout: tile[i * T + k])
+            DenseKernels::trsmRightLowerTranspose(cA.block(start(k), start(k), size(k), size(k)),
+                                                  A.block(start(i), start(k), size(i), size(k)));
+        }
+        
+        // SYRK on the diagonal and GEMM below it: A_ij -= L_ik L_jk^T
+        for (int i = k + 1; i < T; i++) {
+            for (int j = k + 1; j <= i; j++) {
+                #pragma omp task depend(in: tile[i * T + k], tile[j * T + k]) depend(inout: tile[i * T + j])
+                DenseKernels::gemmSubtract(cA.block(start(i), start(k), size(i), size(k)),
+                                           cA.block(start(j), start(k), size(j), size(k)), true,
+                                           A.block(start(i), start(j), size(i), size(j)), tiling);
+            }
+        }
+    }
+    
+    return positiveDefinite;
+}
+
+void TiledDenseSolver::luPanel(DenseMatrix& A, int k0, int end, std::vector<int>& pivotRow,
+                               std::vector<int>& perm) {
+    int n = A.rows();
+    
+    for (int k = k0; k < end; k++) {
+        double maxVal = std::abs(A[k][k]);
+        int maxRow = k;
+        
+        for (int i = k + 1; i < n; i++) {
+            if (std::abs(A[i][k]) > maxVal) {
+                maxVal = std::abs(A[i][k]);
+                maxRow = i;
+            }
+        }
+        
+        pivotRow[k] = maxRow;
+        if (maxRow != k) {
+            std::swap_ranges(A[k] + k0, A[k] + end, A[maxRow] + k0);
+            std::swap(perm[k], perm[maxRow]);
+        }
+        
+        const double* Ak = A[k];
+        if (std::abs(Ak[k]) <= 1e-15) continue;
+        
+        for (int i = k + 1; i < n; i++) {
+            double* Ai = A[i];
+            double lik = Ai[k] / Ak[k];
+            Ai[k] = lik;
+            
+            for (int j = k + 1; j < end; j++) {
+                Ai[j] -= lik * Ak[j];
+            }
+        }
+    }
+}
+
+void TiledDenseSolver::applySwaps(DenseMatrix& A, int k0, int end, const std::vector<int>& pivotRow,
+                                  int c0, int c1) {
+    for (int k = k0; k < end; k++) {
+        if (pivotRow[k] != k) std::swap_ranges(A[k] + c0, A[k] + c1, A[pivotRow[k]] + c0);
+    }
+}
+
+void TiledDenseSolver::luDecompose(DenseMatrix& A, std::vector<int>& perm, int numThreads,
+                                   const DenseKernels::Tiling& tiling) {
+    int n = A.rows();
+    int nb = std::max(1, tiling.panel);
+    int T = (n + nb - 1) / nb;
+    const DenseMatrix& cA = A;
+    std::vector<int> pivotRow(n);
+    
+    // One dependency token per tile column
+    std::vector<char> tokens(T);
+    [[maybe_unused]] char* column = tokens.data();
+    
+    #pragma omp parallel num_threads(numThreads)
+    #pragma omp single
+    for (int k = 0; k < T; k++) {
+        int k0 = k * nb, end = std::min(k0 + nb, n);
+        
+        #pragma omp task depend(inout: column[k])
+        luPanel(A, k0, end, pivotRow, perm);
+        
+        for (int j = 0; j < T; j++) {
+            if (j == k) continue;
+            int c0 = j * nb, c1 = std::min(c0 + nb, n);
+            
+            #pragma omp task depend(in: column[k]) depend(inout: column[j])
+            {
+                applySwaps(A, k0, end, pivotRow, c0, c1);
+                
+                // Right of the panel: U block and the trailing update of this column
+                if (j > k) {
+                    DenseKernels::trsmLeftUnitLower(cA.block(k0, k0, end - k0, end - k0),
+                                                    A.block(k0, c0, end - k0, c1 - c0));
+                    DenseKernels::gemmSubtract(cA.block(end, k0, n - end, end - k0),
+                                               cA.block(k0, c0, end - k0, c1 - c0), false,
+                                               A.block(end, c0, n - end, c1 - c0), tiling);
+                }
+            }
+        }
+    }
+}
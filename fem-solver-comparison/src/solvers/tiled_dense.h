@@ -0,0 +1,38 @@
+#ifndef TILED_DENSE_H
+#define TILED_DENSE_H
+
+#include <vector>
+#include "../matrix/dense_matrix.h"
+#include "../matrix/dense_kernels.h"
+
+// Multithreaded dense factorizations driven by a task DAG. The matrix is cut into
+// panel x panel tiles and every tile kernel becomes an OpenMP task whose depend
+// clauses name the tiles it reads and writes, so the runtime starts a task as soon
+// as its inputs are final and idle threads pick up whatever is ready.
+// Results match LUSolver::decompose / CholeskySolver::decompose in layout.
+class TiledDenseSolver {
+public:
+    // Cholesky (lower, in place) as POTRF / TRSM / SYRK / GEMM tile tasks
+    static bool choleskyDecompose(DenseMatrix& A, int numThreads,
+                                  const DenseKernels::Tiling& tiling = DenseKernels::defaultTiling());
+    
+    // LU with partial pivoting. Pivoting needs a whole column of tiles, so tasks work
+    // on tile columns: a panel task factors column k and records its row swaps, then
+    // one task per other column applies the swaps and (right of the panel) the TRSM
+    // and GEMM updates. Column k + 1 is ready for its panel as soon as its own update
+    // is done, which gives look-ahead without a barrier per step.
+    static void luDecompose(DenseMatrix& A, std::vector<int>& permutation, int numThreads,
+                            const DenseKernels::Tiling& tiling = DenseKernels::defaultTiling());
+
+private:
+    // Unblocked LU of columns k0..end-1 over rows k0..n-1; swaps stay inside the
+    // panel and pivotRow[k] receives the row exchanged with row k
+    static void luPanel(DenseMatrix& A, int k0, int end, std::vector<int>& pivotRow,
+                        std::vector<int>& permutation);
+    
+    // Replay the swaps of panel k0..end-1 on columns c0..c1-1
+    static void applySwaps(DenseMatrix& A, int k0, int end, const std::vector<int>& pivotRow,
+                           int c0, int c1);
+};
+
+#endif
@@ -5,6 +5,8 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include "../matrix/dense_matrix.h"
+#include "../matrix/csr_matrix.h"
 
 class Benchmark {
 public:
@@ -15,6 +17,7 @@ public:
         int iterations;
         double residual;
         std::vector<double> solution;
+        double setupSeconds = 0.0;  // One-time work (factorization, hierarchy) shared by all load cases
     };
     
     // Start timer
@@ -45,7 +48,10 @@ public:
                                const std::vector<double>& reference);
     
     // Compute residual ||K*U - F||
-    static double computeResidual(const std::vector<std::vector<double>>& K,
+    static double computeResidual(const DenseMatrix& K,
+                                 const std::vector<double>& U,
+                                 const std::vector<double>& F);
+    static double computeResidual(const CSRMatrix& K,
                                  const std::vector<double>& U,
                                  const std::vector<double>& F);
     
@@ -55,7 +61,7 @@ public:
     
     // Print comparison table
     static void printComparisonTable(const std::vector<Result>& results);
-    
+
 private:
     static std::chrono::high_resolution_clock::time_point startTime;
 };
@@ -0,0 +1,2235 @@
+#include "performance_studies.h"
+#include "benchmark.h"
+#include "../fem/boundary_conditions.h"
+#include "../matrix/matrix_free_operator.h"
+#include "../matrix/stencil_operator.h"
+#include "../matrix/node_ordering.h"
+#include "../solvers/skyline_solver.h"
+#include "../solvers/supernodal_cholesky.h"
+#include "../solvers/sparse_preconditioners.h"
+#include "../solvers/geometric_multigrid.h"
+#include "../solvers/smoothed_aggregation.h"
+#include "../solvers/tiled_dense.h"
+#include "../solvers/sell_solver.h"
+#include "../solvers/float32_storage.h"
+#include "../solvers/multicolor_sor.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <cstring>
+#include <cmath>
+#include <memory>
+#include <algorithm>
+
+// Puts std::cout back to default notation and its previous precision when a study returns
+struct CoutFormatGuard {
+    std::streamsize precision = std::cout.precision();
+    ~CoutFormatGuard() { std::cout << std::defaultfloat << std::setprecision(precision); }
+};
+
+StiffnessMatrix::MaterialProperties PerformanceStudies::steelPlate() {
+    StiffnessMatrix::MaterialProperties material;
+    material.E = 210e9;   // 210 GPa
+    material.nu = 0.3;
+    material.t = 0.005;   // 5 mm
+    return material;
+}
+
+std::vector<int> PerformanceStudies::threadCounts(int maxThreads) {
+    std::vector<int> counts;
+    for (int t = 1; t < maxThreads; t *= 2) {
+        counts.push_back(t);
+    }
+    counts.push_back(maxThreads);
+    return counts;
+}
+
+// Renumbers before bc is constructed, so the edge nodes are found in the final numbering
+static StiffnessMatrix& renumbered(StiffnessMatrix& mesh, bool rcm) {
+    if (rcm) mesh.renumberNodesRCM();
+    return mesh;
+}
+
+PerformanceStudies::PlateSystem::PlateSystem(int nx, int ny, bool rcm, int numThreads,
+                                             BoundaryConditions::LoadCase loadCase)
+    : mesh(nx, ny, 1.0, 0.5, steelPlate()), bc(renumbered(mesh, rcm)) {
+    bc.generateLoadVector(F, loadCase);
+    if (numThreads > 0) assemble(numThreads);
+}
+
+void PerformanceStudies::PlateSystem::assemble(int numThreads) {
+    mesh.assembleGlobalStiffnessSparse(numThreads);
+    K = mesh.getGlobalKSparse();
+    bc.applyFixedBoundary(K, F);
+}
+
+DenseMatrix PerformanceStudies::PlateSystem::assembleDense() {
+    mesh.assembleGlobalStiffness(1);
+    DenseMatrix Kd = mesh.getGlobalK();
+    std::vector<double> unused(F);
+    bc.applyFixedBoundary(Kd, unused);
+    return Kd;
+}
+
+std::vector<double> PerformanceStudies::PlateSystem::load(BoundaryConditions::LoadCase loadCase) {
+    std::vector<double> f;
+    bc.generateLoadVector(f, loadCase);
+    for (int dof : bc.getFixedDOFs()) f[dof] = 0.0;
+    return f;
+}
+
+std::vector<std::pair<int, int>> PerformanceStudies::refinementSequence(int nx, int ny) {
+    std::vector<std::pair<int, int>> meshes;
+    for (int level = 3; level >= 0; level--) {
+        meshes.push_back({std::max(1, nx >> level), std::max(1, ny >> level)});
+    }
+    return meshes;
+}
+
+std::vector<double> PerformanceStudies::testVector(int n) {
+    std::vector<double> x(n);
+    for (int i = 0; i < n; i++) x[i] = 1.0 + 0.5 * std::sin(i);
+    return x;
+}
+
+double PerformanceStudies::maxRelativeDifference(const std::vector<double>& y,
+                                                 const std::vector<double>& reference) {
+    double maxDiff = 0.0, maxRef = 0.0;
+    for (size_t i = 0; i < y.size(); i++) {
+        maxDiff = std::max(maxDiff, std::abs(y[i] - reference[i]));
+        maxRef = std::max(maxRef, std::abs(reference[i]));
+    }
+    return maxDiff / maxRef;
+}
+
+double PerformanceStudies::residualNorm(const SparseSolver::SparseMatrix& K, const std::vector<double>& U,
+                                        const std::vector<double>& F) {
+    std::vector<double> KU(K.n);
+    SparseSolver::sparseMatVecMult(K, U, KU);
+    double sum = 0.0;
+    for (int i = 0; i < K.n; i++) sum += (F[i] - KU[i]) * (F[i] - KU[i]);
+    return std::sqrt(sum);
+}
+
+void PerformanceStudies::assemblyScaling(int nx, int ny, int maxThreads) {
+    CoutFormatGuard coutFormat;
+    std::cout << "\n=== STUDY: PARALLEL ASSEMBLY SCALING ===" << std::endl;
+    
+    StiffnessMatrix mesh(nx, ny, 1.0, 0.5, steelPlate());
+    
+    // The dense reference is only affordable on small meshes
+    bool checkDense = mesh.getNumDOF() <= 5000;
+    
+    mesh.assembleGlobalStiffnessSparse(1);
+    std::vector<double> referenceCSR = mesh.getGlobalKSparse().values;
+    
+    // Serial reference in plain element order, as the uncolored assembly summed it.
+    // Coloring reorders the additions into each entry, so it need not match bitwise.
+    const auto& pattern = mesh.getGlobalKSparse();
+    std::vector<double> elementOrderCSR(pattern.values.size(), 0.0);
+    for (int e = 0; e < mesh.getNumElements(); e++) {
+        ElementKernel::Matrix8 scratch;
+        const auto& Ke = mesh.elementStiffness(e, scratch);
+        const auto& elem = mesh.getElements()[e];
+        for (int a = 0; a < 8; a++) {
+            int row = 2 * elem.nodes[a / 2] + a % 2;
+            auto begin = pattern.colIndices.begin() + pattern.rowPointers[row];
+            auto end = pattern.colIndices.begin() + pattern.rowPointers[row + 1];
+            for (int b = 0; b < 8; b++) {
+                int col = 2 * elem.nodes[b / 2] + b % 2;
+                elementOrderCSR[std::lower_bound(begin, end, col) - pattern.colIndices.begin()] += Ke[a * 8 + b];
+            }
+        }
+    }
+    
+    DenseMatrix referenceDense;
+    if (checkDense) {
+        mesh.assembleGlobalStiffness(1);
+        referenceDense = mesh.getGlobalK();
+    }
+    
+    struct Row { int threads; double csrTime; double denseTime; bool identical; double elementOrderDiff; };
+    std::vector<Row> rows;
+    
+    for (int threads : threadCounts(maxThreads)) {
+        Row row = {threads, 0.0, 0.0, true, 0.0};
+        
+        row.csrTime = Benchmark::measureTime([&]() { mesh.assembleGlobalStiffnessSparse(threads); });
+        const auto& values = mesh.getGlobalKSparse().values;
+        row.identical = std::memcmp(values.data(), referenceCSR.data(),
+                                    values.size() * sizeof(double)) == 0;
+        row.elementOrderDiff = maxRelativeDifference(values, elementOrderCSR);
+        
+        if (checkDense) {
+            row.denseTime = Benchmark::measureTime([&]() { mesh.assembleGlobalStiffness(threads); });
+            const auto& K = mesh.getGlobalK();
+            for (int i = 0; i < K.rows(); i++) {
+                if (std::memcmp(K[i], referenceDense[i], K.cols() * sizeof(double)) != 0) {
+                    row.identical = false;
+                }
+            }
+        }
+        
+        rows.push_back(row);
+    }
+    
+    std::cout << "\n" << std::string(98, '=') << std::endl;
+    std::cout << "ASSEMBLY SCALING (" << nx << " x " << ny << " elements, "
+              << mesh.getNumDOF() << " DOF)" << std::endl;
+    std::cout << "Bitwise: against the colored assembly on 1 thread; element order: max relative" << std::endl;
+    std::cout << "difference from a serial assembly in element order" << std::endl;
+    std::cout << std::string(98, '=') << std::endl;
+    std::cout << std::setw(10) << "Threads"
+              << std::setw(16) << "CSR time (s)"
+              << std::setw(12) << "Speedup"
+              << std::setw(14) << "Efficiency"
+              << std::setw(16) << "Dense time (s)"
+              << std::setw(12) << "Bitwise"
+              << std::setw(18) << "Element order" << std::endl;
+    std::cout << std::string(98, '-') << std::endl;
+    
+    std::ofstream file("results/assembly_scaling.dat");
+    file << "# Threads CSRTime(s) Speedup Efficiency DenseTime(s) BitwiseIdentical "
+         << "MaxRelDiffElementOrder" << std::endl;
+    
+    for (const auto& row : rows) {
+        double speedup = rows[0].csrTime / row.csrTime;
+        double efficiency = speedup / row.threads;
+        
+        std::cout << std::setw(10) << row.threads
+                  << std::fixed << std::setprecision(6)
+                  << std::setw(16) << row.csrTime
+                  << std::setprecision(2) << std::setw(11) << speedup << "x"
+                  << std::setw(13) << efficiency * 100.0 << "%"
+                  << std::setprecision(6) << std::setw(16) << row.denseTime
+                  << std::setw(12) << (row.identical ? "yes" : "NO")
+                  << std::scientific << std::setprecision(2) << std::setw(18) << row.elementOrderDiff
+                  << std::defaultfloat << std::endl;
+        
+        file << row.threads << " " << row.csrTime << " " << speedup << " "
+             << efficiency << " " << row.denseTime << " " << row.identical << " "
+             << row.elementOrderDiff << std::endl;
+    }
+    
+    std::cout << std::string(98, '=') << std::endl;
+    std::cout << "Results exported to: results/assembly_scaling.dat" << std::endl;
+}
+
+void PerformanceStudies::elementKernelBenchmark(int nx, int ny) {
+    CoutFormatGuard coutFormat;
+    std::cout << "\n=== STUDY: ELEMENT STIFFNESS KERNEL ===" << std::endl;
+    
+    StiffnessMatrix mesh(nx, ny, 1.0, 0.5, steelPlate());
+    int numElements = mesh.getNumElements();
+    
+    // Accuracy: compare the two kernels element by element
+    double maxEntry = 0.0, maxDiff = 0.0;
+    for (int e = 0; e < numElements; e++) {
+        std::vector<std::vector<double>> KeRef;
+        mesh.gaussQuadrature2D(KeRef, e);
+        ElementKernel::Matrix8 Ke;
+        mesh.computeElementStiffness(e, Ke);
+        
+        for (int m = 0; m < 8; m++) {
+            for (int n = 0; n < 8; n++) {
+                maxEntry = std::max(maxEntry, std::abs(KeRef[m][n]));
+                maxDiff = std::max(maxDiff, std::abs(KeRef[m][n] - Ke[m * 8 + n]));
+            }
+        }
+    }
+    
+    // Repeat full passes over the mesh until each kernel has run long enough to time
+    const double minTime = 0.5;
+    double checksum = 0.0;
+    
+    long long refEvaluations = 0;
+    double refTime = 0.0;
+    while (refTime < minTime) {
+        refTime += Benchmark::measureTime([&]() {
+            std::vector<std::vector<double>> Ke;
+            for (int e = 0; e < numElements; e++) {
+                mesh.gaussQuadrature2D(Ke, e);
+                checksum += Ke[0][0];
+            }
+        });
+        refEvaluations += numElements;
+    }
+    
+    long long fixedEvaluations = 0;
+    double fixedTime = 0.0;
+    while (fixedTime < minTime) {
+        fixedTime += Benchmark::measureTime([&]() {
+            ElementKernel::Matrix8 Ke;
+            for (int e = 0; e < numElements; e++) {
+                mesh.computeElementStiffness(e, Ke);
+                checksum += Ke[0];
+            }
+        });
+        fixedEvaluations += numElements;
+    }
+    
+    double refRate = refEvaluations / refTime;
+    double fixedRate = fixedEvaluations / fixedTime;
+    
+    std::cout << "\n" << std::string(70, '=') << std::endl;
+    std::cout << "ELEMENT STIFFNESS KERNEL (" << numElements << " elements per pass)" << std::endl;
+    std::cout << std::string(70, '=') << std::endl;
+    std::cout << std::left << std::setw(34) << "Kernel"
+              << std::right << std::setw(18) << "Ke evals/s"
+              << std::setw(18) << "ns per Ke" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << std::left << std::setw(34) << "Reference (heap matrices)"
+              << std::right << std::setw(18) << refRate
+              << std::setw(18) << std::setprecision(1) << 1e9 / refRate << std::endl;
+    std::cout << std::left << std::setw(34) << "Fixed-size (std::array, fused)"
+              << std::right << std::setw(18) << std::setprecision(0) << fixedRate
+              << std::setw(18) << std::setprecision(1) << 1e9 / fixedRate << std::endl;
+    std::cout << std::string(70, '=') << std::endl;
+    std::cout << "Speedup: " << std::setprecision(2) << fixedRate / refRate << "x" << std::endl;
+    std::cout << "Max |Ke_ref - Ke_fixed| / max|Ke|: " << std::scientific << std::setprecision(3)
+              << maxDiff / maxEntry << std::endl;
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+    
+    std::ofstream file("results/element_kernel.dat");
+    file << "# Kernel EvalsPerSecond NsPerKe" << std::endl;
+    file << "reference " << refRate << " " << 1e9 / refRate << std::endl;
+    file << "fixed_size " << fixedRate << " " << 1e9 / fixedRate << std::endl;
+    std::cout << "Results exported to: results/element_kernel.dat" << std::endl;
+}
+
+void PerformanceStudies::batchedKernelStudy(int nx, int ny) {
+    CoutFormatGuard coutFormat;
+    std::cout << "\n=== STUDY: SIMD-BATCHED ELEMENT KERNEL ===" << std::endl;
+    
+    const int W = ElementKernel::BATCH;
+    
+    // Every interior node jittered, so no two elements share a Ke
+    StiffnessMatrix mesh(nx, ny, 1.0, 0.5, steelPlate());
+    mesh.perturbInteriorNodes(0.2, 1.0);
+    int numElements = mesh.getNumElements();
+    
+    std::vector<int> ids(numElements + W);
+    for (int e = 0; e < numElements + W; e++) ids[e] = e % numElements;
+    
+    // Accuracy: compare the batched lanes against the scalar kernel
+    double maxEntry = 0.0, maxDiff = 0.0;
+    {
+        ElementKernel::ElementBatch batch;
+        ElementKernel::StiffnessBatch KeBatch;
+        auto D = ElementKernel::constitutiveMatrix(steelPlate().E, steelPlate().nu);
+        for (int first = 0; first < numElements; first += W) {
+            int count = std::min(W, numElements - first);
+            mesh.gatherElementBatch(&ids[first], count, batch);
+            ElementKernel::computeStiffnessBatch(batch, D, steelPlate().t, KeBatch);
+            
+            for (int l = 0; l < count; l++) {
+                ElementKernel::Matrix8 Ke;
+                mesh.computeElementStiffness(first + l, Ke);
+                for (int k = 0; k < 64; k++) {
+                    maxEntry = std::max(maxEntry, std::abs(Ke[k]));
+                    maxDiff = std::max(maxDiff, std::abs(Ke[k] - KeBatch.Ke[k][l]));
+                }
+            }
+        }
+    }
+    
+    // Repeat full passes over the mesh until each kernel has run long enough to time
+    const double minTime = 0.5;
+    double checksum = 0.0;
+    
+    long long scalarEvaluations = 0;
+    double scalarTime = 0.0;
+    while (scalarTime < minTime) {
+        scalarTime += Benchmark::measureTime([&]() {
+            ElementKernel::Matrix8 Ke;
+            for (int e = 0; e < numElements; e++) {
+                mesh.computeElementStiffness(e, Ke);
+                checksum += Ke[0];
+            }
+        });
+        scalarEvaluations += numElements;
+    }
+    
+    long long batchEvaluations = 0;
+    double batchTime = 0.0;
+    while (batchTime < minTime) {
+        batchTime += Benchmark::measureTime([&]() {
+            ElementKernel::ElementBatch batch;
+            ElementKernel::StiffnessBatch KeBatch;
+            auto D = ElementKernel::constitutiveMatrix(steelPlate().E, steelPlate().nu);
+            for (int first = 0; first < numElements; first += W) {
+                mesh.gatherElementBatch(&ids[first], std::min(W, numElements - first), batch);
+                ElementKernel::computeStiffnessBatch(batch, D, steelPlate().t, KeBatch);
+                checksum += KeBatch.Ke[0][0];
+            }
+        });
+        batchEvaluations += numElements;
+    }
+    
+    // Uncached CSR assembly with each kernel
+    mesh.setElementCacheEnabled(false);
+    mesh.setBatchedKernelEnabled(false);
+    double scalarAssembly = Benchmark::measureTime([&]() { mesh.assembleGlobalStiffnessSparse(1); });
+    std::vector<double> reference = mesh.getGlobalKSparse().values;
+    
+    mesh.setBatchedKernelEnabled(true);
+    double batchAssembly = Benchmark::measureTime([&]() { mesh.assembleGlobalStiffnessSparse(1); });
+    double assemblyDiff = Benchmark::relativeError(mesh.getGlobalKSparse().values, reference);
+    
+    double scalarRate = scalarEvaluations / scalarTime;
+    double batchRate = batchEvaluations / batchTime;
+    
+    std::cout << "\n" << std::string(84, '=') << std::endl;
+    std::cout << "SIMD-BATCHED ELEMENT KERNEL (" << numElements << " jittered elements, "
+              << W << " lanes)" << std::endl;
+    std::cout << std::string(84, '=') << std::endl;
+    std::cout << std::left << std::setw(30) << "Kernel"
+              << std::right << std::setw(18) << "Ke evals/s"
+              << std::setw(14) << "ns per Ke"
+              << std::setw(22) << "CSR assembly (s)" << std::endl;
+    std::cout << std::string(84, '-') << std::endl;
+    std::cout << std::fixed;
+    std::cout << std::left << std::setw(30) << "Scalar (one element)"
+              << std::right << std::setw(18) << std::setprecision(0) << scalarRate
+              << std::setw(14) << std::setprecision(1) << 1e9 / scalarRate
+              << std::setw(22) << std::setprecision(6) << scalarAssembly << std::endl;
+    std::cout << std::left << std::setw(30) << "Batched (SoA, one per lane)"
+              << std::right << std::setw(18) << std::setprecision(0) << batchRate
+              << std::setw(14) << std::setprecision(1) << 1e9 / batchRate
+              << std::setw(22) << std::setprecision(6) << batchAssembly << std::endl;
+    std::cout << std::string(84, '=') << std::endl;
+    std::cout << "Kernel speedup: " << std::setprecision(2) << batchRate / scalarRate << "x, "
+              << "assembly speedup: " << scalarAssembly / batchAssembly << "x" << std::endl;
+    std::cout << "Max |Ke_scalar - Ke_batch| / max|Ke|: " << std::scientific << std::setprecision(3)
+              << maxDiff / maxEntry << ", assembled K rel. diff: " << assemblyDiff << std::endl;
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+    
+    std::ofstream file("results/batched_kernel.dat");
+    file << "# Kernel EvalsPerSecond NsPerKe AssemblyTime(s)" << std::endl;
+    file << "scalar " << scalarRate << " " << 1e9 / scalarRate << " " << scalarAssembly << std::endl;
+    file << "batched " << batchRate << " " << 1e9 / batchRate << " " << batchAssembly << std::endl;
+    std::cout << "Results exported to: results/batched_kernel.dat" << std::endl;
+}
+
+void PerformanceStudies::elementCacheStudy(int nx, int ny) {
+    CoutFormatGuard coutFormat;
+    std::cout << "\n=== STUDY: ELEMENT STIFFNESS CACHE ===" << std::endl;
+    
+    struct Row {
+        std::string mesh;
+        double uncachedTime, cachedTime;
+        ElementStiffnessCache::Statistics stats;
+        double maxRelDiff;
+    };
+    std::vector<Row> rows;
+    
+    // Uniform grid, then grids with a growing fraction of jittered interior nodes
+    std::vector<double> perturbedFractions = {0.0, 0.01, 0.05, 0.20};
+    
+    for (double fraction : perturbedFractions) {
+        StiffnessMatrix mesh(nx, ny, 1.0, 0.5, steelPlate());
+        if (fraction > 0.0) mesh.perturbInteriorNodes(0.2, fraction);
+        
+        Row row;
+        row.mesh = fraction > 0.0 ? std::to_string((int)(fraction * 100)) + "% nodes jittered"
+                                  : "uniform";
+        
+        mesh.setElementCacheEnabled(false);
+        row.uncachedTime = Benchmark::measureTime([&]() { mesh.assembleGlobalStiffnessSparse(1); });
+        std::vector<double> reference = mesh.getGlobalKSparse().values;
+        
+        mesh.setElementCacheEnabled(true);
+        mesh.clearElementCache();
+        row.cachedTime = Benchmark::measureTime([&]() { mesh.assembleGlobalStiffnessSparse(1); });
+        row.stats = mesh.getElementCacheStatistics();
+        
+        const auto& values = mesh.getGlobalKSparse().values;
+        double maxEntry = 0.0, maxDiff = 0.0;
+        for (size_t k = 0; k < values.size(); k++) {
+            maxEntry = std::max(maxEntry, std::abs(reference[k]));
+            maxDiff = std::max(maxDiff, std::abs(values[k] - reference[k]));
+        }
+        row.maxRelDiff = maxDiff / maxEntry;
+        
+        rows.push_back(row);
+    }
+    
+    std::cout << "\n" << std::string(96, '=') << std::endl;
+    std::cout << "ELEMENT STIFFNESS CACHE (" << nx << " x " << ny << " elements, CSR assembly, 1 thread)"
+              << std::endl;
+    std::cout << std::string(96, '=') << std::endl;
+    std::cout << std::left << std::setw(24) << "Mesh"
+              << std::right << std::setw(12) << "Unique Ke"
+              << std::setw(12) << "Hit rate"
+              << std::setw(16) << "No cache (s)"
+              << std::setw(14) << "Cached (s)"
+              << std::setw(10) << "Speedup"
+              << std::setw(8) << "" << "Max rel diff" << std::endl;
+    std::cout << std::string(96, '-') << std::endl;
+    
+    std::ofstream file("results/element_cache.dat");
+    file << "# JitteredFraction UniqueKe HitRate UncachedTime(s) CachedTime(s) Speedup MaxRelDiff" << std::endl;
+    
+    for (size_t r = 0; r < rows.size(); r++) {
+        const auto& row = rows[r];
+        double speedup = row.uncachedTime / row.cachedTime;
+        
+        std::cout << std::left << std::setw(24) << row.mesh
+                  << std::right << std::setw(12) << row.stats.entries
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(11) << 100.0 * row.stats.hitRate() << "%"
+                  << std::setprecision(6)
+                  << std::setw(16) << row.uncachedTime
+                  << std::setw(14) << row.cachedTime
+                  << std::setprecision(2) << std::setw(9) << speedup << "x"
+                  << std::setw(8) << "" << std::scientific << std::setprecision(2)
+                  << row.maxRelDiff << std::endl;
+        
+        file << perturbedFractions[r] << " " << row.stats.entries << " " << row.stats.hitRate() << " "
+             << row.uncachedTime << " " << row.cachedTime << " " << speedup << " "
+             << row.maxRelDiff << std::endl;
+    }
+    
+    std::cout << std::string(96, '=') << std::endl;
+    std::cout << "Results exported to: results/element_cache.dat" << std::endl;
+}
+
+void PerformanceStudies::matrixFreeStudy(int nx, int ny, int numThreads) {
+    CoutFormatGuard coutFormat;
+    std::cout << "\n=== STUDY: MATRIX-FREE OPERATOR ===" << std::endl;
+    
+    PlateSystem plate(nx, ny, false, numThreads);
+    
+    // Assembled path: CSR assembly plus boundary conditions, from a cold element cache
+    plate.mesh.clearElementCache();
+    double csrSetup = Benchmark::measureTime([&]() { plate.assemble(numThreads); });
+    CSROperator csrK(plate.K);
+    
+    // Matrix-free path: only the element matrix cache is prepared
+    plate.mesh.clearElementCache();
+    Benchmark::start();
+    MatrixFreeStiffnessOperator mfK(plate.mesh, plate.bc.getFixedDOFs(), numThreads);
+    double mfSetup = Benchmark::stop();
+    
+    // Time per operator application
+    const int numApplies = 20;
+    std::vector<double> x(plate.K.n), y(plate.K.n);
+    for (int i = 0; i < plate.K.n; i++) x[i] = std::sin(0.001 * i);
+    
+    double csrApply = Benchmark::measureTime([&]() {
+        for (int k = 0; k < numApplies; k++) csrK.apply(x, y);
+    }) / numApplies;
+    std::vector<double> yCSR = y;
+    
+    double mfApply = Benchmark::measureTime([&]() {
+        for (int k = 0; k < numApplies; k++) mfK.apply(x, y);
+    }) / numApplies;
+    double applyDiff = Benchmark::relativeError(y, yCSR);
+    
+    // Full CG solves
+    std::vector<double> U_csr, U_mf;
+    double csrSolve = Benchmark::measureTime([&]() { U_csr = SparseSolver::sparseCG(csrK, plate.F); });
+    double mfSolve = Benchmark::measureTime([&]() { U_mf = SparseSolver::sparseCG(mfK, plate.F); });
+    double solutionDiff = Benchmark::relativeError(U_mf, U_csr);
+    
+    std::cout << "\n" << std::string(86, '=') << std::endl;
+    std::cout << "MATRIX-FREE vs CSR (" << nx << " x " << ny << " elements, " << plate.K.n
+              << " DOF, " << numThreads << " threads)" << std::endl;
+    std::cout << std::string(86, '=') << std::endl;
+    std::cout << std::left << std::setw(14) << "Operator"
+              << std::right << std::setw(14) << "Memory (MB)"
+              << std::setw(14) << "Setup (s)"
+              << std::setw(16) << "K*x (ms)"
+              << std::setw(14) << "CG solve (s)" << std::endl;
+    std::cout << std::string(86, '-') << std::endl;
+    std::cout << std::fixed;
+    std::cout << std::left << std::setw(14) << "CSR" << std::right
+              << std::setprecision(3) << std::setw(14) << csrK.memoryBytes() / (1024.0 * 1024.0)
+              << std::setprecision(6) << std::setw(14) << csrSetup
+              << std::setprecision(3) << std::setw(16) << csrApply * 1e3
+              << std::setprecision(6) << std::setw(14) << csrSolve << std::endl;
+    std::cout << std::left << std::setw(14) << "Matrix-free" << std::right
+              << std::setprecision(3) << std::setw(14) << mfK.memoryBytes() / (1024.0 * 1024.0)
+              << std::setprecision(6) << std::setw(14) << mfSetup
+              << std::setprecision(3) << std::setw(16) << mfApply * 1e3
+              << std::setprecision(6) << std::setw(14) << mfSolve << std::endl;
+    std::cout << std::string(86, '=') << std::endl;
+    std::cout << std::scientific << std::setprecision(3);
+    std::cout << "Relative difference of K*x: " << applyDiff << std::endl;
+    std::cout << "Relative difference of U:   " << solutionDiff << std::endl;
+    
+    std::ofstream file("results/matrix_free.dat");
+    file << "# Operator MemoryMB Setup(s) Apply(s) Solve(s)" << std::endl;
+    file << "CSR " << csrK.memoryBytes() / (1024.0 * 1024.0) << " " << csrSetup << " "
+         << csrApply << " " << csrSolve << std::endl;
+    file << "MatrixFree " << mfK.memoryBytes() / (1024.0 * 1024.0) << " " << mfSetup << " "
+         << mfApply << " " << mfSolve << std::endl;
+    std::cout << "Results exported to: results/matrix_free.dat" << std::endl;
+}
+
+void PerformanceStudies::stencilStudy(int nx, int ny, int numThreads) {
+    CoutFormatGuard coutFormat;
+    std::cout << "\n=== STUDY: STENCIL OPERATOR ===" << std::endl;
+    
+    PlateSystem plate(nx, ny, false, numThreads);
+    
+    CSROperator csrK(plate.K);
+    StencilOperator stencilK(plate.mesh, plate.bc.getFixedDOFs(), numThreads);
+    
+    int n = plate.K.n;
+    std::vector<double> x(n), yCSR(n), yStencil(n);
+    for (int i = 0; i < n; i++) x[i] = std::sin(0.001 * i);
+    
+    // Enough products for a stable timing
+    const int numApplies = std::max(10, (int)(2e8 / plate.K.values.size()));
+    
+    double csrTime = Benchmark::measureTime([&]() {
+        for (int k = 0; k < numApplies; k++) SparseSolver::sparseMatVecMult(plate.K, x, yCSR);
+    }) / numApplies;
+    double stencilTime = Benchmark::measureTime([&]() {
+        for (int k = 0; k < numApplies; k++) stencilK.apply(x, yStencil);
+    }) / numApplies;
+    double applyDiff = Benchmark::relativeError(yStencil, yCSR);
+    
+    // Bytes streamed per product: CSR reads values, indices, row pointers and x, writes y;
+    // the stencil only touches x and y
+    double csrBytes = plate.K.values.size() * (sizeof(double) + sizeof(int)) +
+                      (n + 1) * sizeof(int) + 2.0 * n * sizeof(double);
+    double stencilBytes = 2.0 * n * sizeof(double);
+    double flops = 2.0 * plate.K.values.size();
+    
+    std::vector<double> U_csr, U_stencil;
+    double csrSolve = Benchmark::measureTime([&]() { U_csr = SparseSolver::sparseCG(csrK, plate.F); });
+    double stencilSolve = Benchmark::measureTime([&]() { U_stencil = SparseSolver::sparseCG(stencilK, plate.F); });
+    double solutionDiff = Benchmark::relativeError(U_stencil, U_csr);
+    
+    std::cout << "\n" << std::string(92, '=') << std::endl;
+    std::cout << "STENCIL vs CSR SpMV (" << nx << " x " << ny << " elements, " << n
+              << " DOF, nnz " << plate.K.values.size() << ", threads " << numThreads << ")" << std::endl;
+    std::cout << std::string(92, '=') << std::endl;
+    std::cout << std::left << std::setw(12) << "Operator"
+              << std::right << std::setw(14) << "Memory (MB)"
+              << std::setw(14) << "K*x (ms)"
+              << std::setw(14) << "GFLOP/s"
+              << std::setw(14) << "GB/s"
+              << std::setw(10) << "Speedup"
+              << std::setw(14) << "CG solve (s)" << std::endl;
+    std::cout << std::string(92, '-') << std::endl;
+    std::cout << std::fixed;
+    std::cout << std::left << std::setw(12) << "CSR" << std::right
+              << std::setprecision(3) << std::setw(14) << csrK.memoryBytes() / (1024.0 * 1024.0)
+              << std::setw(14) << csrTime * 1e3
+              << std::setprecision(2) << std::setw(14) << flops / csrTime * 1e-9
+              << std::setw(14) << csrBytes / csrTime * 1e-9
+              << std::setw(9) << 1.0 << "x"
+              << std::setprecision(6) << std::setw(14) << csrSolve << std::endl;
+    std::cout << std::left << std::setw(12) << "Stencil" << std::right
+              << std::setprecision(3) << std::setw(14) << stencilK.memoryBytes() / (1024.0 * 1024.0)
+              << std::setw(14) << stencilTime * 1e3
+              << std::setprecision(2) << std::setw(14) << flops / stencilTime * 1e-9
+              << std::setw(14) << stencilBytes / stencilTime * 1e-9
+              << std::setw(9) << csrTime / stencilTime << "x"
+              << std::setprecision(6) << std::setw(14) << stencilSolve << std::endl;
+    std::cout << std::string(92, '=') << std::endl;
+    std::cout << std::scientific << std::setprecision(3);
+    std::cout << "Relative difference of K*x: " << applyDiff << std::endl;
+    std::cout << "Relative difference of U:   " << solutionDiff << std::endl;
+    
+    std::ofstream file("results/stencil_spmv.dat");
+    file << "# Operator MemoryMB Apply(s) GFLOPs GBs CGSolve(s)" << std::endl;
+    file << "CSR " << csrK.memoryBytes() / (1024.0 * 1024.0) << " " << csrTime << " "
+         << flops / csrTime * 1e-9 << " " << csrBytes / csrTime * 1e-9 << " " << csrSolve << std::endl;
+    file << "Stencil " << stencilK.memoryBytes() / (1024.0 * 1024.0) << " " << stencilTime << " "
+         << flops / stencilTime * 1e-9 << " " << stencilBytes / stencilTime * 1e-9 << " "
+         << stencilSolve << std::endl;
+    std::cout << "Results exported to: results/stencil_spmv.dat" << std::endl;
+}
+
+void PerformanceStudies::nodeOrderingStudy(int nx, int ny) {
+    CoutFormatGuard coutFormat;
+    std::cout << "\n=== STUDY: NODE ORDERING (REVERSE CUTHILL-MCKEE) ===" << std::endl;
+    
+    struct Row {
+        std::string key, ordering;
+        NodeOrdering::Envelope env;
+        double spmvTime, cgTime;
+        double tipDisplacement;
+    };
+    std::vector<Row> rows;
+    
+    for (bool rcm : {false, true}) {
+        PlateSystem plate(nx, ny, rcm);
+        
+        Row row;
+        row.key = rcm ? "rcm" : "row_major";
+        row.ordering = rcm ? "Reverse Cuthill-McKee" : "Row-major (generateMesh)";
+        row.env = NodeOrdering::envelope(NodeOrdering::nodalGraph(plate.mesh.getElements(),
+                                                                  plate.mesh.getNumNodes()));
+        
+        
+        const int numProducts = 20;
+        std::vector<double> x(plate.K.n), y(plate.K.n);
+        for (int i = 0; i < plate.K.n; i++) x[i] = std::sin(0.001 * i);
+        row.spmvTime = Benchmark::measureTime([&]() {
+            for (int k = 0; k < numProducts; k++) SparseSolver::sparseMatVecMult(plate.K, x, y);
+        }) / numProducts;
+        
+        std::vector<double> U;
+        row.cgTime = Benchmark::measureTime([&]() { U = SparseSolver::sparseCG(plate.K, plate.F, false); });
+        row.tipDisplacement = U[2 * plate.mesh.latticeNode(nx, ny)];
+        
+        rows.push_back(row);
+    }
+    
+    std::cout << "\n" << std::string(100, '=') << std::endl;
+    std::cout << "NODE ORDERING (" << nx << " x " << ny << " elements, "
+              << 2 * (nx + 1) * (ny + 1) << " DOF)" << std::endl;
+    std::cout << std::string(100, '=') << std::endl;
+    std::cout << std::left << std::setw(28) << "Ordering"
+              << std::right << std::setw(11) << "Bandwidth"
+              << std::setw(15) << "Profile"
+              << std::setw(14) << "Band (MB)"
+              << std::setw(14) << "SpMV (ms)"
+              << std::setw(10) << "CG (s)"
+              << std::setw(8) << "" << "Tip u (m)" << std::endl;
+    std::cout << std::string(100, '-') << std::endl;
+    
+    std::ofstream file("results/node_ordering.dat");
+    file << "# Ordering Bandwidth Profile BandMB SpMVTime(s) CGTime(s) TipU(m)" << std::endl;
+    
+    int n = 2 * (nx + 1) * (ny + 1);
+    for (const auto& row : rows) {
+        double bandMB = (double)n * row.env.bandwidth * sizeof(double) / (1024.0 * 1024.0);
+        
+        std::cout << std::left << std::setw(28) << row.ordering
+                  << std::right << std::setw(11) << row.env.bandwidth
+                  << std::setw(15) << row.env.profile
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(14) << bandMB
+                  << std::setprecision(3) << std::setw(14) << 1e3 * row.spmvTime
+                  << std::setw(10) << row.cgTime
+                  << std::setw(8) << "" << std::scientific << std::setprecision(6)
+                  << row.tipDisplacement << std::endl;
+        
+        file << row.key << " "
+             << row.env.bandwidth << " " << row.env.profile << " " << bandMB << " "
+             << row.spmvTime << " " << row.cgTime << " " << row.tipDisplacement << std::endl;
+    }
+    
+    std::cout << std::string(100, '=') << std::endl;
+    std::cout << "Bandwidth reduction: " << std::fixed << std::setprecision(2)
+              << (double)rows[0].env.bandwidth / rows[1].env.bandwidth << "x, profile reduction: "
+              << (double)rows[0].env.profile / rows[1].env.profile << "x" << std::endl;
+    std::cout << "Results exported to: results/node_ordering.dat" << std::endl;
+}
+
+void PerformanceStudies::skylineStudy(int nx, int ny) {
+    CoutFormatGuard coutFormat;
+    std::cout << "\n=== STUDY: SKYLINE LDL^T ===" << std::endl;
+    
+    struct Row {
+        std::string key, ordering;
+        long long envelope;
+        double memoryMB, factorTime, solveTime, cgTime;
+        double skylineResidual, difference;
+    };
+    std::vector<Row> rows;
+    
+    for (bool rcm : {false, true}) {
+        PlateSystem plate(nx, ny, rcm);
+        
+        
+        Row row;
+        row.key = rcm ? "rcm" : "row_major";
+        row.ordering = rcm ? "Reverse Cuthill-McKee" : "Row-major";
+        
+        SkylineSolver::SkylineMatrix A;
+        row.factorTime = Benchmark::measureTime([&]() {
+            A = SkylineSolver::fromCSR(plate.K);
+            SkylineSolver::decompose(A);
+        });
+        row.envelope = A.values.size();
+        row.memoryMB = SkylineSolver::memoryMB(A);
+        
+        std::vector<double> U;
+        row.solveTime = Benchmark::measureTime([&]() { U = SkylineSolver::solveLDLT(A, plate.F); });
+        
+        row.skylineResidual = residualNorm(plate.K, U, plate.F) /
+                              std::sqrt(ConjugateGradientSolver::dotProduct(plate.F, plate.F));
+        
+        std::vector<double> Ucg;
+        row.cgTime = Benchmark::measureTime([&]() { Ucg = SparseSolver::sparseCG(plate.K, plate.F, false); });
+        row.difference = Benchmark::relativeError(Ucg, U);
+        
+        rows.push_back(row);
+    }
+    
+    std::cout << "\n" << std::string(108, '=') << std::endl;
+    std::cout << "SKYLINE LDL^T (" << nx << " x " << ny << " elements, "
+              << 2 * (nx + 1) * (ny + 1) << " DOF)" << std::endl;
+    std::cout << std::string(108, '=') << std::endl;
+    std::cout << std::left << std::setw(24) << "Ordering"
+              << std::right << std::setw(14) << "Envelope"
+              << std::setw(12) << "Mem (MB)"
+              << std::setw(13) << "Factor (s)"
+              << std::setw(12) << "Solve (s)"
+              << std::setw(10) << "CG (s)"
+              << std::setw(15) << "|KU-F|/|F|"
+              << std::setw(8) << "" << "|U_cg-U|" << std::endl;
+    std::cout << std::string(108, '-') << std::endl;
+    
+    std::ofstream file("results/skyline.dat");
+    file << "# Ordering Envelope MemoryMB FactorTime(s) SolveTime(s) CGTime(s) RelResidual CGDifference"
+         << std::endl;
+    
+    for (const auto& row : rows) {
+        std::cout << std::left << std::setw(24) << row.ordering
+                  << std::right << std::setw(14) << row.envelope
+                  << std::fixed << std::setprecision(2) << std::setw(12) << row.memoryMB
+                  << std::setprecision(3) << std::setw(13) << row.factorTime
+                  << std::setw(12) << row.solveTime
+                  << std::setw(10) << row.cgTime
+                  << std::scientific << std::setprecision(2) << std::setw(15) << row.skylineResidual
+                  << std::setw(8) << "" << row.difference << std::endl;
+        
+        file << row.key << " " << row.envelope << " " << row.memoryMB << " " << row.factorTime << " "
+             << row.solveTime << " " << row.cgTime << " " << row.skylineResidual << " "
+             << row.difference << std::endl;
+    }
+    
+    std::cout << std::string(108, '=') << std::endl;
+    std::cout << "Results exported to: results/skyline.dat" << std::endl;
+}
+
+void PerformanceStudies::sparseCholeskyStudy(int nx, int ny) {
+    CoutFormatGuard coutFormat;
+    std::cout << "\n=== STUDY: SUPERNODAL SPARSE CHOLESKY ===" << std::endl;
+    
+    // RCM-numbered mesh: the skyline solver's best case and the natural order below
+    PlateSystem plate(nx, ny);
+    
+    auto relativeResidual = [&plate](const std::vector<double>& U) {
+        return residualNorm(plate.K, U, plate.F) /
+               std::sqrt(ConjugateGradientSolver::dotProduct(plate.F, plate.F));
+    };
+    
+    struct Row {
+        std::string key, method;
+        long long nnzL;
+        double flops, memoryMB, analyzeTime, factorTime, solveTime, residual;
+    };
+    std::vector<Row> rows;
+    
+    for (auto ordering : {SupernodalCholeskySolver::NATURAL, SupernodalCholeskySolver::NESTED_DISSECTION}) {
+        Row row;
+        bool nd = ordering == SupernodalCholeskySolver::NESTED_DISSECTION;
+        row.key = nd ? "supernodal_nd" : "supernodal_rcm";
+        row.method = nd ? "Supernodal, nested dissection" : "Supernodal, RCM order";
+        
+        SupernodalCholeskySolver::Symbolic S;
+        row.analyzeTime = Benchmark::measureTime([&]() { S = SupernodalCholeskySolver::analyze(plate.K, ordering); });
+        
+        std::vector<double> L;
+        row.factorTime = Benchmark::measureTime([&]() { SupernodalCholeskySolver::factorize(plate.K, S, L); });
+        
+        std::vector<double> U;
+        row.solveTime = Benchmark::measureTime([&]() { U = SupernodalCholeskySolver::solveFactor(S, L, plate.F); });
+        
+        row.nnzL = S.nnzL;
+        row.flops = S.flops;
+        row.memoryMB = SupernodalCholeskySolver::memoryMB(S);
+        row.residual = relativeResidual(U);
+        rows.push_back(row);
+    }
+    
+    {
+        Row row;
+        row.key = "skyline_rcm";
+        row.method = "Skyline LDL^T, RCM order";
+        row.analyzeTime = 0.0;
+        
+        SkylineSolver::SkylineMatrix A;
+        row.factorTime = Benchmark::measureTime([&]() {
+            A = SkylineSolver::fromCSR(plate.K);
+            SkylineSolver::decompose(A);
+        });
+        std::vector<double> U;
+        row.solveTime = Benchmark::measureTime([&]() { U = SkylineSolver::solveLDLT(A, plate.F); });
+        
+        // The envelope is stored in full; its flops follow from the row lengths
+        row.nnzL = A.values.size();
+        row.flops = 0.0;
+        for (int i = 0; i < A.n; i++) {
+            double rowLength = i - A.firstCol[i] + 1;
+            row.flops += rowLength * rowLength;
+        }
+        row.memoryMB = SkylineSolver::memoryMB(A);
+        row.residual = relativeResidual(U);
+        rows.push_back(row);
+    }
+    
+    long long nnzA = 0;
+    for (int i = 0; i < plate.K.n; i++) {
+        for (int k = plate.K.rowPointers[i]; k < plate.K.rowPointers[i + 1]; k++) {
+            if (plate.K.colIndices[k] <= i) nnzA++;
+        }
+    }
+    
+    std::vector<double> Ucg;
+    double cgTime = Benchmark::measureTime([&]() { Ucg = SparseSolver::sparseCG(plate.K, plate.F, false); });
+    
+    std::cout << "\n" << std::string(120, '=') << std::endl;
+    std::cout << "SPARSE DIRECT SOLVERS (" << nx << " x " << ny << " elements, " << plate.K.n
+              << " DOF, nnz(tril A) " << nnzA << ")" << std::endl;
+    std::cout << std::string(120, '=') << std::endl;
+    std::cout << std::left << std::setw(32) << "Method"
+              << std::right << std::setw(12) << "nnz(L)"
+              << std::setw(8) << "Fill"
+              << std::setw(11) << "GFlop"
+              << std::setw(11) << "Mem (MB)"
+              << std::setw(12) << "Analyze (s)"
+              << std::setw(12) << "Factor (s)"
+              << std::setw(11) << "Solve (s)"
+              << std::setw(11) << "GFLOP/s" << std::endl;
+    std::cout << std::string(120, '-') << std::endl;
+    
+    std::ofstream file("results/sparse_cholesky.dat");
+    file << "# Method nnzL Fill GFlop MemoryMB AnalyzeTime(s) FactorTime(s) SolveTime(s) GFLOPs RelResidual"
+         << std::endl;
+    
+    for (const auto& row : rows) {
+        std::cout << std::left << std::setw(32) << row.method
+                  << std::right << std::setw(12) << row.nnzL
+                  << std::fixed << std::setprecision(1) << std::setw(8) << (double)row.nnzL / nnzA
+                  << std::setprecision(2) << std::setw(11) << row.flops / 1e9
+                  << std::setw(11) << row.memoryMB
+                  << std::setprecision(3) << std::setw(12) << row.analyzeTime
+                  << std::setw(12) << row.factorTime
+                  << std::setw(11) << row.solveTime
+                  << std::setprecision(2) << std::setw(11) << row.flops / row.factorTime / 1e9 << std::endl;
+        
+        file << row.key << " " << row.nnzL << " " << (double)row.nnzL / nnzA << " " << row.flops / 1e9 << " "
+             << row.memoryMB << " " << row.analyzeTime << " " << row.factorTime << " " << row.solveTime << " "
+             << row.flops / row.factorTime / 1e9 << " " << row.residual << std::endl;
+    }
+    
+    std::cout << std::string(120, '=') << std::endl;
+    std::cout << "Sparse CG for comparison: " << std::setprecision(3) << cgTime << " s" << std::endl;
+    std::cout << "Relative residuals |KU-F|/|F|:";
+    for (const auto& row : rows) std::cout << " " << std::scientific << std::setprecision(2) << row.residual;
+    std::cout << std::endl;
+    std::cout << "Results exported to: results/sparse_cholesky.dat" << std::endl;
+}
+
+void PerformanceStudies::preconditionerStudy(int nx, int ny) {
+    CoutFormatGuard coutFormat;
+    std::cout << "\n=== STUDY: PRECONDITIONED CG ===" << std::endl;
+    
+    struct Row {
+        int nx, ny, ndof;
+        std::string preconditioner;
+        int iterations;
+        double setupTime, solveTime;
+    };
+    std::vector<Row> rows;
+    
+    const std::vector<std::string> names = {"None", "Jacobi", "SSOR", "IC(0)"};
+    
+    // Refinement sequence ending at the requested mesh
+    for (const auto& size : refinementSequence(nx, ny)) {
+        int mx = size.first, my = size.second;
+        
+        PlateSystem plate(mx, my);
+        CSROperator op(plate.K);
+        
+        for (const auto& name : names) {
+            Row row = {mx, my, plate.K.n, name, 0, 0.0, 0.0};
+            
+            std::unique_ptr<Preconditioner> M;
+            row.setupTime = Benchmark::measureTime([&]() {
+                if (name == "Jacobi") M = std::make_unique<JacobiPreconditioner>(plate.K);
+                else if (name == "SSOR") M = std::make_unique<SSORPreconditioner>(plate.K);
+                else if (name == "IC(0)") M = std::make_unique<IncompleteCholeskyPreconditioner>(plate.K);
+            });
+            row.solveTime = Benchmark::measureTime([&]() {
+                SparseSolver::preconditionedCG(op, M.get(), plate.F, false, &row.iterations);
+            });
+            
+            rows.push_back(row);
+        }
+    }
+    
+    std::cout << "\n" << std::string(86, '=') << std::endl;
+    std::cout << "PRECONDITIONED CG (|r| < 1e-8, RCM numbering, 1 thread)" << std::endl;
+    std::cout << std::string(86, '=') << std::endl;
+    std::cout << std::left << std::setw(14) << "Mesh"
+              << std::right << std::setw(10) << "DOF"
+              << std::setw(16) << "Preconditioner"
+              << std::setw(12) << "Iterations"
+              << std::setw(12) << "Setup (s)"
+              << std::setw(12) << "Solve (s)"
+              << std::setw(10) << "Total (s)" << std::endl;
+    std::cout << std::string(86, '-') << std::endl;
+    
+    std::ofstream file("results/preconditioned_cg.dat");
+    file << "# nx ny DOF Preconditioner Iterations SetupTime(s) SolveTime(s) TotalTime(s)" << std::endl;
+    
+    for (size_t k = 0; k < rows.size(); k++) {
+        const auto& row = rows[k];
+        std::string mesh = std::to_string(row.nx) + " x " + std::to_string(row.ny);
+        if (k > 0 && rows[k - 1].ndof == row.ndof) mesh = "";
+        
+        std::cout << std::left << std::setw(14) << mesh
+                  << std::right << std::setw(10) << (mesh.empty() ? "" : std::to_string(row.ndof))
+                  << std::setw(16) << row.preconditioner
+                  << std::setw(12) << row.iterations
+                  << std::fixed << std::setprecision(4)
+                  << std::setw(12) << row.setupTime
+                  << std::setw(12) << row.solveTime
+                  << std::setw(10) << row.setupTime + row.solveTime << std::endl;
+        
+        file << row.nx << " " << row.ny << " " << row.ndof << " " << row.preconditioner << " "
+             << row.iterations << " " << row.setupTime << " " << row.solveTime << " "
+             << row.setupTime + row.solveTime << std::endl;
+    }
+    
+    std::cout << std::string(86, '=') << std::endl;
+    std::cout << "Results exported to: results/preconditioned_cg.dat" << std::endl;
+}
+
+void PerformanceStudies::multigridStudy(int nx, int ny) {
+    CoutFormatGuard coutFormat;
+    std::cout << "\n=== STUDY: GEOMETRIC MULTIGRID ===" << std::endl;
+    
+    struct Row {
+        int nx, ny, ndof, levels;
+        std::string method;
+        int iterations;
+        double setupTime, solveTime;
+    };
+    std::vector<Row> rows;
+    
+    const std::vector<std::string> methods = {"PCG (IC(0))", "MG V-cycle", "PCG (MG)"};
+    
+    // Refinement sequence ending at the requested mesh
+    for (const auto& size : refinementSequence(nx, ny)) {
+        int mx = size.first, my = size.second;
+        
+        PlateSystem plate(mx, my);
+        CSROperator op(plate.K);
+        
+        for (const auto& method : methods) {
+            Row row = {mx, my, plate.K.n, 0, method, 0, 0.0, 0.0};
+            
+            if (method == "PCG (IC(0))") {
+                std::unique_ptr<Preconditioner> M;
+                row.setupTime = Benchmark::measureTime([&]() {
+                    M = std::make_unique<IncompleteCholeskyPreconditioner>(plate.K);
+                });
+                row.solveTime = Benchmark::measureTime([&]() {
+                    SparseSolver::preconditionedCG(op, M.get(), plate.F, false, &row.iterations);
+                });
+            } else {
+                std::unique_ptr<GeometricMultigrid> mg;
+                row.setupTime = Benchmark::measureTime([&]() {
+                    mg = std::make_unique<GeometricMultigrid>(plate.mesh, plate.K, plate.bc.getFixedDOFs());
+                });
+                row.levels = mg->getNumLevels();
+                row.solveTime = Benchmark::measureTime([&]() {
+                    if (method == "MG V-cycle") mg->solve(plate.F, false, &row.iterations);
+                    else SparseSolver::preconditionedCG(op, mg.get(), plate.F, false, &row.iterations);
+                });
+            }
+            
+            rows.push_back(row);
+        }
+    }
+    
+    std::cout << "\n" << std::string(100, '=') << std::endl;
+    std::cout << "GEOMETRIC MULTIGRID (|r| < 1e-8, RCM numbering, 2+2 Gauss-Seidel sweeps, 1 thread)" << std::endl;
+    std::cout << std::string(100, '=') << std::endl;
+    std::cout << std::left << std::setw(14) << "Mesh"
+              << std::right << std::setw(10) << "DOF"
+              << std::setw(8) << "Levels"
+              << std::setw(14) << "Method"
+              << std::setw(12) << "Iterations"
+              << std::setw(12) << "Setup (s)"
+              << std::setw(12) << "Solve (s)"
+              << std::setw(10) << "Total (s)"
+              << std::setw(8) << "us/DOF" << std::endl;
+    std::cout << std::string(100, '-') << std::endl;
+    
+    std::ofstream file("results/multigrid.dat");
+    file << "# nx ny DOF Levels Method Iterations SetupTime(s) SolveTime(s) TotalTime(s) TimePerDOF(us)" << std::endl;
+    
+    for (size_t k = 0; k < rows.size(); k++) {
+        const auto& row = rows[k];
+        std::string mesh = std::to_string(row.nx) + " x " + std::to_string(row.ny);
+        if (k > 0 && rows[k - 1].ndof == row.ndof) mesh = "";
+        double total = row.setupTime + row.solveTime;
+        double perDOF = 1e6 * total / row.ndof;
+        
+        // Methods are written without spaces so the .dat columns stay whitespace-separated
+        std::string tag = row.method;
+        tag.erase(std::remove(tag.begin(), tag.end(), ' '), tag.end());
+        
+        std::cout << std::left << std::setw(14) << mesh
+                  << std::right << std::setw(10) << (mesh.empty() ? "" : std::to_string(row.ndof))
+                  << std::setw(8) << (row.levels ? std::to_string(row.levels) : "-")
+                  << std::setw(14) << row.method
+                  << std::setw(12) << row.iterations
+                  << std::fixed << std::setprecision(4)
+                  << std::setw(12) << row.setupTime
+                  << std::setw(12) << row.solveTime
+                  << std::setw(10) << total
+                  << std::setprecision(2) << std::setw(8) << perDOF << std::endl;
+        
+        file << row.nx << " " << row.ny << " " << row.ndof << " " << row.levels << " " << tag << " "
+             << row.iterations << " " << row.setupTime << " " << row.solveTime << " "
+             << total << " " << perDOF << std::endl;
+    }
+    
+    std::cout << std::string(100, '=') << std::endl;
+    std::cout << "Results exported to: results/multigrid.dat" << std::endl;
+}
+
+void PerformanceStudies::algebraicMultigridStudy(int nx, int ny) {
+    CoutFormatGuard coutFormat;
+    std::cout << "\n=== STUDY: SMOOTHED-AGGREGATION AMG ===" << std::endl;
+    
+    struct Row {
+        int nx, ny, ndof;
+        std::string method;
+        int levels;
+        double complexity;
+        double iterations;       // Average over the load cases
+        double setupTime, solveTime;
+    };
+    std::vector<Row> rows;
+    
+    const std::vector<BoundaryConditions::LoadCase> loadCases = {
+        BoundaryConditions::UNIFORM_5KN,
+        BoundaryConditions::UNIFORM_10KN,
+        BoundaryConditions::LINEAR_VARYING,
+        BoundaryConditions::CONCENTRATED_15KN,
+        BoundaryConditions::ANGLED_10KN
+    };
+    
+    // Refinement sequence ending at the requested mesh
+    for (const auto& size : refinementSequence(nx, ny)) {
+        int mx = size.first, my = size.second;
+        
+        PlateSystem plate(mx, my);
+        std::vector<std::vector<double>> loads;
+        for (auto loadCase : loadCases) loads.push_back(plate.load(loadCase));
+        CSROperator op(plate.K);
+        
+        for (std::string method : {"Geometric MG", "SA-AMG"}) {
+            Row row = {mx, my, plate.K.n, method, 0, 0.0, 0.0, 0.0, 0.0};
+            
+            // Setup once, then solve every load case with the same hierarchy
+            std::unique_ptr<Multigrid> mg;
+            row.setupTime = Benchmark::measureTime([&]() {
+                if (method == "SA-AMG") mg = std::make_unique<SmoothedAggregationAMG>(plate.K, plate.mesh.getNodes());
+                else mg = std::make_unique<GeometricMultigrid>(plate.mesh, plate.K, plate.bc.getFixedDOFs());
+            });
+            row.levels = mg->getNumLevels();
+            row.complexity = mg->operatorComplexity();
+            
+            for (const auto& F : loads) {
+                int iterations = 0;
+                row.solveTime += Benchmark::measureTime([&]() {
+                    SparseSolver::preconditionedCG(op, mg.get(), F, false, &iterations);
+                });
+                row.iterations += iterations;
+            }
+            row.solveTime /= loads.size();
+            row.iterations /= loads.size();
+            
+            rows.push_back(row);
+        }
+    }
+    
+    std::cout << "\n" << std::string(100, '=') << std::endl;
+    std::cout << "MULTIGRID-PRECONDITIONED CG (|r| < 1e-8, " << loadCases.size()
+              << " load cases per hierarchy, 1 thread)" << std::endl;
+    std::cout << std::string(100, '=') << std::endl;
+    std::cout << std::left << std::setw(14) << "Mesh"
+              << std::right << std::setw(10) << "DOF"
+              << std::setw(15) << "Method"
+              << std::setw(8) << "Levels"
+              << std::setw(10) << "Op. cx"
+              << std::setw(10) << "Iters"
+              << std::setw(12) << "Setup (s)"
+              << std::setw(11) << "Solve (s)"
+              << std::setw(10) << "All (s)" << std::endl;
+    std::cout << std::string(100, '-') << std::endl;
+    
+    std::ofstream file("results/algebraic_multigrid.dat");
+    file << "# nx ny DOF Method Levels OperatorComplexity AvgIterations SetupTime(s) "
+         << "SolveTimePerCase(s) TotalTimeAllCases(s)" << std::endl;
+    
+    for (size_t k = 0; k < rows.size(); k++) {
+        const auto& row = rows[k];
+        std::string mesh = std::to_string(row.nx) + " x " + std::to_string(row.ny);
+        if (k > 0 && rows[k - 1].ndof == row.ndof) mesh = "";
+        double total = row.setupTime + row.solveTime * loadCases.size();
+        std::string tag = row.method == "SA-AMG" ? "SA-AMG" : "GMG";
+        
+        std::cout << std::left << std::setw(14) << mesh
+                  << std::right << std::setw(10) << (mesh.empty() ? "" : std::to_string(row.ndof))
+                  << std::setw(15) << row.method
+                  << std::setw(8) << row.levels
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(10) << row.complexity
+                  << std::setprecision(1) << std::setw(10) << row.iterations
+                  << std::setprecision(4)
+                  << std::setw(12) << row.setupTime
+                  << std::setw(11) << row.solveTime
+                  << std::setw(10) << total << std::endl;
+        
+        file << row.nx << " " << row.ny << " " << row.ndof << " " << tag << " " << row.levels << " "
+             << row.complexity << " " << row.iterations << " " << row.setupTime << " "
+             << row.solveTime << " " << total << std::endl;
+    }
+    
+    std::cout << std::string(100, '=') << std::endl;
+    std::cout << "Results exported to: results/algebraic_multigrid.dat" << std::endl;
+}
+
+void PerformanceStudies::multipleRHSStudy(int nx, int ny) {
+    CoutFormatGuard coutFormat;
+    std::cout << "\n=== STUDY: MULTIPLE RIGHT-HAND SIDES ===" << std::endl;
+    
+    PlateSystem plate(nx, ny);
+    CSROperator op(plate.K);
+    int n = plate.K.n;
+    double nnz = plate.K.values.size();
+    
+    // Load vectors cycle through the five load cases, scaled so no two are equal
+    const BoundaryConditions::LoadCase cases[] = {
+        BoundaryConditions::UNIFORM_5KN, BoundaryConditions::UNIFORM_10KN,
+        BoundaryConditions::LINEAR_VARYING, BoundaryConditions::CONCENTRATED_15KN,
+        BoundaryConditions::ANGLED_10KN
+    };
+    std::vector<std::vector<double>> loads(8);
+    for (int j = 0; j < 8; j++) {
+        loads[j] = plate.load(cases[j % 5]);
+        for (double& f : loads[j]) f *= 1.0 + j / 5;
+    }
+    
+    std::cout << "Mesh: " << nx << " x " << ny << ", DOF: " << n << ", nnz: " << (long long)nnz << std::endl;
+    
+    struct Row {
+        int k;
+        double spmvSeparate, spmvBlock;   // Seconds per vector
+        double cgSeparate, cgBatched;     // Seconds for all k solves
+        int maxIterations;
+    };
+    std::vector<Row> rows;
+    const int repeats = 20;
+    
+    for (int k : {1, 2, 4, 5, 8}) {
+        Row row = {k, 0.0, 0.0, 0.0, 0.0, 0};
+        
+        std::vector<double> x(n, 1.0), y(n);
+        std::vector<double> X((size_t)n * k, 1.0), Y((size_t)n * k);
+        row.spmvSeparate = Benchmark::measureTime([&]() {
+            for (int r = 0; r < repeats; r++) {
+                for (int j = 0; j < k; j++) SparseSolver::sparseMatVecMult(plate.K, x, y);
+            }
+        }) / (repeats * k);
+        row.spmvBlock = Benchmark::measureTime([&]() {
+            for (int r = 0; r < repeats; r++) SparseSolver::sparseMatMultiVec(plate.K, X, Y, k);
+        }) / (repeats * k);
+        
+        std::vector<std::vector<double>> B(loads.begin(), loads.begin() + k);
+        row.cgSeparate = Benchmark::measureTime([&]() {
+            for (int j = 0; j < k; j++) SparseSolver::sparseCG(op, B[j]);
+        });
+        std::vector<int> iterations;
+        row.cgBatched = Benchmark::measureTime([&]() {
+            SparseSolver::batchedCG(op, nullptr, B, false, &iterations);
+        });
+        row.maxIterations = *std::max_element(iterations.begin(), iterations.end());
+        
+        rows.push_back(row);
+    }
+    
+    std::cout << "\n" << std::string(104, '=') << std::endl;
+    std::cout << "BLOCK SPMV AND BATCHED CG (RCM numbering, 1 thread)" << std::endl;
+    std::cout << std::string(104, '=') << std::endl;
+    std::cout << std::right << std::setw(4) << "k"
+              << std::setw(12) << "Flop/byte"
+              << std::setw(16) << "SpMV 1x (ms)"
+              << std::setw(16) << "SpMV blk (ms)"
+              << std::setw(10) << "Speedup"
+              << std::setw(14) << "CG 1x (s)"
+              << std::setw(14) << "CG blk (s)"
+              << std::setw(10) << "Speedup"
+              << std::setw(8) << "Iters" << std::endl;
+    std::cout << std::string(104, '-') << std::endl;
+    
+    std::ofstream file("results/multiple_rhs.dat");
+    file << "# k FlopPerByte SpMVSeparate(s/vec) SpMVBlock(s/vec) SpMVSpeedup CGSeparate(s) CGBatched(s) "
+         << "CGSpeedup MaxIterations" << std::endl;
+    
+    for (const auto& row : rows) {
+        // 2 flops per entry and vector; matrix traffic (value + index) is shared by the
+        // k vectors, plus one read and one write of each vector entry
+        double bytes = nnz * (sizeof(double) + sizeof(int)) + (n + 1) * sizeof(int) +
+                       2.0 * n * row.k * sizeof(double);
+        double intensity = 2.0 * nnz * row.k / bytes;
+        double spmvSpeedup = row.spmvSeparate / row.spmvBlock;
+        double cgSpeedup = row.cgSeparate / row.cgBatched;
+        
+        std::cout << std::setw(4) << row.k
+                  << std::fixed << std::setprecision(3) << std::setw(12) << intensity
+                  << std::setprecision(4)
+                  << std::setw(16) << row.spmvSeparate * 1e3
+                  << std::setw(16) << row.spmvBlock * 1e3
+                  << std::setprecision(2) << std::setw(9) << spmvSpeedup << "x"
+                  << std::setprecision(4)
+                  << std::setw(14) << row.cgSeparate
+                  << std::setw(14) << row.cgBatched
+                  << std::setprecision(2) << std::setw(9) << cgSpeedup << "x"
+                  << std::setw(8) << row.maxIterations << std::endl;
+        
+        file << row.k << " " << intensity << " " << row.spmvSeparate << " " << row.spmvBlock << " "
+             << spmvSpeedup << " " << row.cgSeparate << " " << row.cgBatched << " " << cgSpeedup << " "
+             << row.maxIterations << std::endl;
+    }
+    
+    std::cout << std::string(104, '=') << std::endl;
+    std::cout << "Results exported to: results/multiple_rhs.dat" << std::endl;
+}
+
+void PerformanceStudies::denseFactorizationStudy(int nx, int ny) {
+    CoutFormatGuard coutFormat;
+    std::cout << "\n=== STUDY: BLOCKED DENSE FACTORIZATION ===" << std::endl;
+    
+    struct Row {
+        int nx, ny, ndof;
+        std::string method;
+        double time, gflops, residual;
+    };
+    std::vector<Row> rows;
+    
+    DenseMatrix largestK;
+    std::vector<double> largestF;
+    
+    for (int divisor : {16, 12, 10, 8}) {
+        int mx = std::max(1, nx / divisor);
+        int my = std::max(1, ny / divisor);
+        
+        PlateSystem plate(mx, my, true, 0);
+        DenseMatrix K = plate.assembleDense();
+        const std::vector<double>& F = plate.F;
+        double n = K.rows();
+        
+        for (int method = 0; method < 4; method++) {
+            bool lu = method < 2, blocked = method % 2 == 1;
+            Row row = {mx, my, K.rows(), std::string(lu ? "LU" : "Cholesky") + (blocked ? " blocked" : ""),
+                       0.0, 0.0, 0.0};
+            
+            DenseMatrix A = K;
+            std::vector<int> perm(K.rows());
+            for (int i = 0; i < K.rows(); i++) perm[i] = i;
+            
+            row.time = Benchmark::measureTime([&]() {
+                if (lu && blocked) LUSolver::decompose(A, perm);
+                else if (lu) LUSolver::decomposeUnblocked(A, perm);
+                else if (blocked) CholeskySolver::decompose(A);
+                else CholeskySolver::decomposeUnblocked(A.view());
+            });
+            
+            auto U = lu ? LUSolver::solveLU(A, perm, F) : CholeskySolver::solveCholesky(A, F);
+            row.residual = Benchmark::computeResidual(K, U, F);
+            row.gflops = (lu ? 2.0 : 1.0) * n * n * n / 3.0 / row.time * 1e-9;
+            rows.push_back(row);
+        }
+        
+        largestK = std::move(K);
+        largestF = F;
+    }
+    
+    std::cout << "\n" << std::string(82, '=') << std::endl;
+    std::cout << "DENSE LU / CHOLESKY: UNBLOCKED VS BLOCKED (" << DenseKernels::MR << "x" << DenseKernels::NR
+              << " micro-kernel, panel " << DenseKernels::defaultTiling().panel << ", 1 thread)" << std::endl;
+    std::cout << std::string(82, '=') << std::endl;
+    std::cout << std::left << std::setw(12) << "Mesh"
+              << std::right << std::setw(8) << "DOF"
+              << std::setw(18) << "Method"
+              << std::setw(12) << "Time (s)"
+              << std::setw(10) << "GFLOP/s"
+              << std::setw(10) << "Speedup"
+              << std::setw(12) << "Residual" << std::endl;
+    std::cout << std::string(82, '-') << std::endl;
+    
+    std::ofstream file("results/dense_blocked.dat");
+    file << "# nx ny DOF Method Time(s) GFLOPs Speedup Residual" << std::endl;
+    
+    for (size_t k = 0; k < rows.size(); k++) {
+        const auto& row = rows[k];
+        std::string mesh = std::to_string(row.nx) + " x " + std::to_string(row.ny);
+        if (k % 4 != 0) mesh = "";
+        double speedup = rows[k - k % 2].time / row.time;
+        
+        std::cout << std::left << std::setw(12) << mesh
+                  << std::right << std::setw(8) << (mesh.empty() ? "" : std::to_string(row.ndof))
+                  << std::setw(18) << row.method
+                  << std::fixed << std::setprecision(4) << std::setw(12) << row.time
+                  << std::setprecision(2) << std::setw(10) << row.gflops
+                  << std::setw(9) << speedup << "x"
+                  << std::scientific << std::setprecision(3) << std::setw(12) << row.residual << std::endl;
+        
+        std::string method = row.method;
+        std::replace(method.begin(), method.end(), ' ', '_');
+        file << row.nx << " " << row.ny << " " << row.ndof << " " << method << " " << row.time << " "
+             << row.gflops << " " << speedup << " " << row.residual << std::endl;
+    }
+    std::cout << std::string(82, '=') << std::endl;
+    
+    // Panel width sweep on the largest matrix
+    double n = largestK.rows();
+    std::cout << "\nPanel width (DOF: " << largestK.rows() << ")" << std::endl;
+    std::cout << std::right << std::setw(8) << "Panel"
+              << std::setw(16) << "LU GFLOP/s"
+              << std::setw(18) << "Cholesky GFLOP/s" << std::endl;
+    
+    file << "# Panel LUGFLOPs CholeskyGFLOPs (DOF " << largestK.rows() << ")" << std::endl;
+    
+    for (int panel : {16, 32, 64, 96, 128, 192}) {
+        DenseKernels::Tiling tiling = DenseKernels::defaultTiling();
+        tiling.panel = panel;
+        
+        DenseMatrix A = largestK;
+        std::vector<int> perm(largestK.rows());
+        for (int i = 0; i < largestK.rows(); i++) perm[i] = i;
+        double luTime = Benchmark::measureTime([&]() { LUSolver::decompose(A, perm, tiling); });
+        
+        A = largestK;
+        double choleskyTime = Benchmark::measureTime([&]() { CholeskySolver::decompose(A, tiling); });
+        
+        double luGflops = 2.0 * n * n * n / 3.0 / luTime * 1e-9;
+        double choleskyGflops = n * n * n / 3.0 / choleskyTime * 1e-9;
+        std::cout << std::setw(8) << panel << std::fixed << std::setprecision(2)
+                  << std::setw(16) << luGflops << std::setw(18) << choleskyGflops << std::endl;
+        file << panel << " " << luGflops << " " << choleskyGflops << std::endl;
+    }
+    
+    std::cout << "Results exported to: results/dense_blocked.dat" << std::endl;
+}
+
+void PerformanceStudies::tiledFactorizationScaling(int nx, int ny, int maxThreads) {
+    CoutFormatGuard coutFormat;
+    std::cout << "\n=== STUDY: TASK-PARALLEL TILED FACTORIZATION ===" << std::endl;
+    
+    int mx = std::max(1, nx / 6);
+    int my = std::max(1, ny / 6);
+    PlateSystem plate(mx, my, true, 0);
+    DenseMatrix K = plate.assembleDense();
+    const std::vector<double>& F = plate.F;
+    int n = K.rows();
+    double luFlops = 2.0 * n * (double)n * n / 3.0;
+    double choleskyFlops = n * (double)n * n / 3.0;
+    
+    std::vector<int> identity(n);
+    for (int i = 0; i < n; i++) identity[i] = i;
+    
+    // Serial blocked factorizations as the reference
+    DenseMatrix A = K;
+    std::vector<int> perm = identity;
+    double luSerial = Benchmark::measureTime([&]() { LUSolver::decompose(A, perm); });
+    A = K;
+    double choleskySerial = Benchmark::measureTime([&]() { CholeskySolver::decompose(A); });
+    
+    struct Row {
+        int threads;
+        double luTime, choleskyTime;
+        double luResidual, choleskyResidual;
+    };
+    std::vector<Row> rows;
+    
+    for (int threads : threadCounts(maxThreads)) {
+        Row row = {threads, 0.0, 0.0, 0.0, 0.0};
+        
+        A = K;
+        perm = identity;
+        row.luTime = Benchmark::measureTime([&]() { TiledDenseSolver::luDecompose(A, perm, threads); });
+        row.luResidual = Benchmark::computeResidual(K, LUSolver::solveLU(A, perm, F), F);
+        
+        A = K;
+        row.choleskyTime = Benchmark::measureTime([&]() { TiledDenseSolver::choleskyDecompose(A, threads); });
+        row.choleskyResidual = Benchmark::computeResidual(K, CholeskySolver::solveCholesky(A, F), F);
+        
+        rows.push_back(row);
+    }
+    
+    std::cout << "\n" << std::string(92, '=') << std::endl;
+    std::cout << "TILED LU / CHOLESKY STRONG SCALING (" << mx << " x " << my << " elements, " << n
+              << " DOF, tile " << DenseKernels::defaultTiling().panel << ")" << std::endl;
+    std::cout << "Serial blocked: LU " << std::fixed << std::setprecision(4) << luSerial << " s ("
+              << std::setprecision(2) << luFlops / luSerial * 1e-9 << " GFLOP/s), Cholesky "
+              << std::setprecision(4) << choleskySerial << " s (" << std::setprecision(2)
+              << choleskyFlops / choleskySerial * 1e-9 << " GFLOP/s)" << std::endl;
+    std::cout << std::string(92, '=') << std::endl;
+    std::cout << std::right << std::setw(8) << "Threads"
+              << std::setw(12) << "LU (s)"
+              << std::setw(10) << "GFLOP/s"
+              << std::setw(10) << "Speedup"
+              << std::setw(14) << "Cholesky (s)"
+              << std::setw(10) << "GFLOP/s"
+              << std::setw(10) << "Speedup"
+              << std::setw(18) << "Residual LU/Chol" << std::endl;
+    std::cout << std::string(92, '-') << std::endl;
+    
+    std::ofstream file("results/tiled_scaling.dat");
+    file << "# Threads LUTime(s) LUGFLOPs LUSpeedup CholeskyTime(s) CholeskyGFLOPs CholeskySpeedup "
+         << "LUResidual CholeskyResidual (speedups vs serial blocked)" << std::endl;
+    
+    for (const auto& row : rows) {
+        double luSpeedup = luSerial / row.luTime;
+        double choleskySpeedup = choleskySerial / row.choleskyTime;
+        
+        std::cout << std::setw(8) << row.threads
+                  << std::fixed << std::setprecision(4) << std::setw(12) << row.luTime
+                  << std::setprecision(2) << std::setw(10) << luFlops / row.luTime * 1e-9
+                  << std::setw(9) << luSpeedup << "x"
+                  << std::setprecision(4) << std::setw(14) << row.choleskyTime
+                  << std::setprecision(2) << std::setw(10) << choleskyFlops / row.choleskyTime * 1e-9
+                  << std::setw(9) << choleskySpeedup << "x"
+                  << std::scientific << std::setprecision(1) << std::setw(10) << row.luResidual
+                  << std::setw(8) << row.choleskyResidual << std::endl;
+        
+        file << row.threads << " " << row.luTime << " " << luFlops / row.luTime * 1e-9 << " " << luSpeedup << " "
+             << row.choleskyTime << " " << choleskyFlops / row.choleskyTime * 1e-9 << " " << choleskySpeedup << " "
+             << row.luResidual << " " << row.choleskyResidual << std::endl;
+    }
+    
+    std::cout << std::string(92, '=') << std::endl;
+    std::cout << "Results exported to: results/tiled_scaling.dat" << std::endl;
+}
+
+void PerformanceStudies::parallelCGScaling(int nx, int ny, int maxThreads) {
+    CoutFormatGuard coutFormat;
+    std::cout << "\n=== STUDY: PARALLEL SPARSE CG ===" << std::endl;
+    
+    int mx = nx, my = ny;
+    while (2LL * (mx + 1) * (my + 1) < 1000000) {
+        mx += std::max(1, nx / 4);
+        my += std::max(1, ny / 4);
+    }
+    
+    PlateSystem plate(mx, my, true, maxThreads);
+    int n = plate.K.n;
+    
+    const int spmvRepeats = 20;
+    const int cgIterations = 200;
+    
+    struct Row {
+        int threads;
+        double imbalanceRows, imbalanceNnz;  // Largest range nnz / average
+        double spmvRows, spmvNnz;            // Seconds per product
+        double cgTime;
+        double residual;
+    };
+    std::vector<Row> rows;
+    
+    // Largest nnz share of any range relative to the average
+    auto imbalance = [&plate](const std::vector<int>& partition) {
+        int parts = partition.size() - 1;
+        double largest = 0.0;
+        for (int t = 0; t < parts; t++) {
+            largest = std::max(largest, (double)(plate.K.rowPointers[partition[t + 1]] - plate.K.rowPointers[partition[t]]));
+        }
+        return largest * parts / plate.K.values.size();
+    };
+    
+    std::vector<double> x(n, 1.0), y(n);
+    
+    for (int threads : threadCounts(maxThreads)) {
+        Row row = {threads, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        
+        std::vector<int> byRows(threads + 1);
+        for (int t = 0; t <= threads; t++) byRows[t] = (long long)n * t / threads;
+        std::vector<int> byNnz = SparseSolver::balancedRowPartition(plate.K, threads);
+        row.imbalanceRows = imbalance(byRows);
+        row.imbalanceNnz = imbalance(byNnz);
+        
+        row.spmvRows = Benchmark::measureTime([&]() {
+            for (int r = 0; r < spmvRepeats; r++) SparseSolver::parallelMatVecMult(plate.K, x, y, byRows);
+        }) / spmvRepeats;
+        row.spmvNnz = Benchmark::measureTime([&]() {
+            for (int r = 0; r < spmvRepeats; r++) SparseSolver::parallelMatVecMult(plate.K, x, y, byNnz);
+        }) / spmvRepeats;
+        
+        std::vector<double> U;
+        row.cgTime = Benchmark::measureTime([&]() {
+            U = SparseSolver::parallelCG(plate.K, plate.F, threads, false, nullptr, cgIterations);
+        });
+        
+        // Residual after the fixed iteration count; identical for every thread count
+        // up to the order of the dot-product partial sums
+        row.residual = residualNorm(plate.K, U, plate.F);
+        
+        rows.push_back(row);
+    }
+    
+    std::cout << "\n" << std::string(100, '=') << std::endl;
+    std::cout << "PARALLEL CSR SPMV AND CG (" << mx << " x " << my << " elements, " << n << " DOF, "
+              << plate.K.values.size() << " nnz, " << cgIterations << " CG iterations)" << std::endl;
+    std::cout << std::string(100, '=') << std::endl;
+    std::cout << std::right << std::setw(8) << "Threads"
+              << std::setw(16) << "Imbal rows/nnz"
+              << std::setw(16) << "SpMV rows (ms)"
+              << std::setw(15) << "SpMV nnz (ms)"
+              << std::setw(12) << "CG (s)"
+              << std::setw(10) << "Speedup"
+              << std::setw(12) << "Efficiency"
+              << std::setw(11) << "Residual" << std::endl;
+    std::cout << std::string(100, '-') << std::endl;
+    
+    std::ofstream file("results/parallel_cg.dat");
+    file << "# Threads ImbalanceRows ImbalanceNnz SpMVRows(s) SpMVNnz(s) CGTime(s) Speedup Efficiency Residual"
+         << std::endl;
+    
+    for (const auto& row : rows) {
+        double speedup = rows[0].cgTime / row.cgTime;
+        double efficiency = speedup / row.threads;
+        
+        std::cout << std::setw(8) << row.threads
+                  << std::fixed << std::setprecision(3) << std::setw(9) << row.imbalanceRows
+                  << " / " << std::setw(5) << row.imbalanceNnz
+                  << std::setprecision(3) << std::setw(16) << row.spmvRows * 1e3
+                  << std::setw(15) << row.spmvNnz * 1e3
+                  << std::setprecision(4) << std::setw(12) << row.cgTime
+                  << std::setprecision(2) << std::setw(9) << speedup << "x"
+                  << std::setw(11) << efficiency * 100.0 << "%"
+                  << std::scientific << std::setprecision(3) << std::setw(11) << row.residual << std::endl;
+        
+        file << row.threads << " " << row.imbalanceRows << " " << row.imbalanceNnz << " " << row.spmvRows << " "
+             << row.spmvNnz << " " << row.cgTime << " " << speedup << " " << efficiency << " " << row.residual
+             << std::endl;
+    }
+    
+    std::cout << std::string(100, '=') << std::endl;
+    std::cout << "Results exported to: results/parallel_cg.dat" << std::endl;
+}
+
+void PerformanceStudies::blockSparseStudy(int nx, int ny) {
+    CoutFormatGuard coutFormat;
+    std::cout << "\n=== STUDY: BLOCK CSR (BSR 2x2) ===" << std::endl;
+    
+    PlateSystem plate(nx, ny);
+    plate.mesh.assembleGlobalStiffnessBSR(1);
+    BSRSolver::BSRMatrix Kb = plate.mesh.getGlobalKBSR();
+    std::vector<double> F_bsr = plate.F;
+    plate.bc.applyFixedBoundary(Kb, F_bsr);
+    int n = plate.K.n;
+    
+    // Both formats must give the same product
+    std::vector<double> x = testVector(n), yCSR(n), yBSR(n);
+    SparseSolver::sparseMatVecMult(plate.K, x, yCSR);
+    BSRSolver::multiply(Kb, x, yBSR);
+    double maxDiff = maxRelativeDifference(yBSR, yCSR);
+    
+    struct Row {
+        std::string format;
+        double storage, indexBytes;
+        double spmvTime;
+        int iterations;
+        double cgTime;
+    };
+    const int repeats = 50;
+    
+    CSROperator csrOp(plate.K);
+    BSROperator bsrOp(Kb);
+    Row rows[2] = {
+        {"CSR", csrOp.memoryBytes(), (double)(plate.K.colIndices.size() + plate.K.rowPointers.size()) * sizeof(int), 0.0, 0, 0.0},
+        {"BSR 2x2", bsrOp.memoryBytes(), (double)(Kb.colIndices.size() + Kb.rowPointers.size()) * sizeof(int),
+         0.0, 0, 0.0}
+    };
+    const LinearOperator* ops[2] = {&csrOp, &bsrOp};
+    
+    for (int f = 0; f < 2; f++) {
+        std::vector<double> y(n);
+        rows[f].spmvTime = Benchmark::measureTime([&]() {
+            for (int r = 0; r < repeats; r++) ops[f]->apply(x, y);
+        }) / repeats;
+        rows[f].cgTime = Benchmark::measureTime([&]() {
+            SparseSolver::sparseCG(*ops[f], plate.F, false, &rows[f].iterations);
+        });
+    }
+    
+    std::cout << "\n" << std::string(100, '=') << std::endl;
+    std::cout << "BSR 2x2 VS CSR (" << nx << " x " << ny << " elements, " << n << " DOF, RCM numbering, "
+              << "max |y_CSR - y_BSR| / max |y| = " << std::scientific << std::setprecision(1)
+              << maxDiff << ")" << std::endl;
+    std::cout << std::string(100, '=') << std::endl;
+    std::cout << std::left << std::setw(10) << "Format"
+              << std::right << std::setw(14) << "Storage (MB)"
+              << std::setw(14) << "Indices (MB)"
+              << std::setw(14) << "SpMV (ms)"
+              << std::setw(12) << "GB/s"
+              << std::setw(10) << "Speedup"
+              << std::setw(12) << "CG iters"
+              << std::setw(14) << "CG (s)" << std::endl;
+    std::cout << std::string(100, '-') << std::endl;
+    
+    std::ofstream file("results/bsr.dat");
+    file << "# Format StorageMB IndexMB SpMVTime(s) GBps SpMVSpeedup CGIterations CGTime(s)" << std::endl;
+    
+    for (const auto& row : rows) {
+        // Matrix streamed once, x read and y written once
+        double bytes = row.storage + 2.0 * n * sizeof(double);
+        double bandwidth = bytes / row.spmvTime * 1e-9;
+        double speedup = rows[0].spmvTime / row.spmvTime;
+        
+        std::cout << std::left << std::setw(10) << row.format << std::right
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(14) << row.storage / (1024.0 * 1024.0)
+                  << std::setw(14) << row.indexBytes / (1024.0 * 1024.0)
+                  << std::setw(14) << row.spmvTime * 1e3
+                  << std::setprecision(2) << std::setw(12) << bandwidth
+                  << std::setw(9) << speedup << "x"
+                  << std::setw(12) << row.iterations
+                  << std::setprecision(4) << std::setw(14) << row.cgTime << std::endl;
+        
+        std::string format = row.format == "CSR" ? "CSR" : "BSR2x2";
+        file << format << " " << row.storage / (1024.0 * 1024.0) << " " << row.indexBytes / (1024.0 * 1024.0)
+             << " " << row.spmvTime << " " << bandwidth << " " << speedup << " " << row.iterations << " "
+             << row.cgTime << std::endl;
+    }
+    
+    std::cout << std::string(100, '=') << std::endl;
+    std::cout << "Results exported to: results/bsr.dat" << std::endl;
+}
+
+void PerformanceStudies::slicedEllpackStudy(int nx, int ny) {
+    CoutFormatGuard coutFormat;
+    std::cout << "\n=== STUDY: SLICED ELLPACK (SELL-C-SIGMA) ===" << std::endl;
+    
+    PlateSystem plate(nx, ny);
+    int n = plate.K.n;
+    
+    std::vector<double> x = testVector(n), yCSR(n);
+    SparseSolver::sparseMatVecMult(plate.K, x, yCSR);
+    
+    struct Row {
+        std::string format;
+        int sigma;
+        double storage, padding;
+        double spmvTime, maxDiff;
+        int iterations;
+        double cgTime;  // Zero where CG was not run
+    };
+    const int repeats = 50;
+    const int C = SELLSolver::C;
+    const int defaultSigma = 32 * C;
+    
+    // Sigma = C is plain SELL-C (no sorting); sigma = n sorts the whole matrix
+    BSRSolver::BSRMatrix Kb = BSRSolver::fromCSR(plate.K);
+    std::vector<int> sigmas = {C, 4 * C, defaultSigma, 1024 * C, n};
+    std::vector<SELLSolver::SELLMatrix> sell;
+    for (int sigma : sigmas) sell.push_back(SELLSolver::fromCSR(plate.K, sigma));
+    
+    std::vector<std::unique_ptr<LinearOperator>> ops;
+    std::vector<Row> rows;
+    ops.push_back(std::make_unique<CSROperator>(plate.K));
+    rows.push_back({"CSR", 0, ops.back()->memoryBytes(), 0.0, 0.0, 0.0, 0, 0.0});
+    ops.push_back(std::make_unique<BSROperator>(Kb));
+    rows.push_back({"BSR 2x2", 0, ops.back()->memoryBytes(), 0.0, 0.0, 0.0, 0, 0.0});
+    for (const auto& S : sell) {
+        ops.push_back(std::make_unique<SELLOperator>(S));
+        rows.push_back({"SELL-" + std::to_string(C), S.sigma, ops.back()->memoryBytes(),
+                        SELLSolver::paddingOverhead(S), 0.0, 0.0, 0, 0.0});
+    }
+    
+    for (size_t f = 0; f < ops.size(); f++) {
+        std::vector<double> y(n);
+        ops[f]->apply(x, y);
+        rows[f].maxDiff = maxRelativeDifference(y, yCSR);
+        rows[f].spmvTime = Benchmark::measureTime([&]() {
+            for (int r = 0; r < repeats; r++) ops[f]->apply(x, y);
+        }) / repeats;
+    }
+    
+    // CG through sparseCG's format switch (conversion included) for each format at its default
+    struct Solve { size_t row; SparseSolver::SpMVFormat format; };
+    size_t defaultRow = 2 + (std::find(sigmas.begin(), sigmas.end(), defaultSigma) - sigmas.begin());
+    Solve solves[3] = {{0, SparseSolver::SpMVFormat::CSR}, {1, SparseSolver::SpMVFormat::BSR},
+                       {defaultRow, SparseSolver::SpMVFormat::SELL}};
+    for (const auto& s : solves) {
+        rows[s.row].cgTime = Benchmark::measureTime([&]() {
+            SparseSolver::sparseCG(plate.K, plate.F, false, &rows[s.row].iterations, s.format);
+        });
+    }
+    
+    std::cout << "\n" << std::string(110, '=') << std::endl;
+    std::cout << "SELL-C-SIGMA VS CSR AND BSR (" << nx << " x " << ny << " elements, " << n << " DOF, "
+              << plate.K.values.size() << " nnz, C = " << C << ", RCM numbering)" << std::endl;
+    std::cout << std::string(110, '=') << std::endl;
+    std::cout << std::left << std::setw(10) << "Format"
+              << std::right << std::setw(9) << "Sigma"
+              << std::setw(14) << "Storage (MB)"
+              << std::setw(11) << "Padding"
+              << std::setw(12) << "SpMV (ms)"
+              << std::setw(10) << "GB/s"
+              << std::setw(10) << "Speedup"
+              << std::setw(12) << "Max diff"
+              << std::setw(10) << "CG iters"
+              << std::setw(12) << "CG (s)" << std::endl;
+    std::cout << std::string(110, '-') << std::endl;
+    
+    std::ofstream file("results/sell.dat");
+    file << "# Format Sigma StorageMB Padding SpMVTime(s) GBps SpMVSpeedup MaxDiff CGIterations CGTime(s)"
+         << std::endl;
+    
+    for (const auto& row : rows) {
+        // Matrix streamed once (padding included), x read and y written once
+        double bytes = row.storage + 2.0 * n * sizeof(double);
+        double bandwidth = bytes / row.spmvTime * 1e-9;
+        double speedup = rows[0].spmvTime / row.spmvTime;
+        
+        std::cout << std::left << std::setw(10) << row.format << std::right
+                  << std::setw(9) << (row.sigma > 0 ? std::to_string(row.sigma) : "-")
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(14) << row.storage / (1024.0 * 1024.0)
+                  << std::setprecision(2) << std::setw(10) << row.padding * 100.0 << "%"
+                  << std::setprecision(3) << std::setw(12) << row.spmvTime * 1e3
+                  << std::setprecision(2) << std::setw(10) << bandwidth
+                  << std::setw(9) << speedup << "x"
+                  << std::scientific << std::setprecision(1) << std::setw(12) << row.maxDiff;
+        if (row.cgTime > 0.0) {
+            std::cout << std::setw(10) << row.iterations
+                      << std::fixed << std::setprecision(4) << std::setw(12) << row.cgTime << std::endl;
+        } else {
+            std::cout << std::setw(10) << "-" << std::setw(12) << "-" << std::endl;
+        }
+        
+        std::string format = row.format == "BSR 2x2" ? "BSR2x2" : row.format;
+        file << format << " " << row.sigma << " " << row.storage / (1024.0 * 1024.0) << " " << row.padding << " "
+             << row.spmvTime << " " << bandwidth << " " << speedup << " " << row.maxDiff << " "
+             << row.iterations << " " << row.cgTime << std::endl;
+    }
+    
+    std::cout << std::string(110, '=') << std::endl;
+    std::cout << "Results exported to: results/sell.dat" << std::endl;
+}
+
+void PerformanceStudies::float32StorageStudy(int nx, int ny) {
+    CoutFormatGuard coutFormat;
+    std::cout << "\n=== STUDY: FLOAT32 SPARSE MATRIX STORAGE ===" << std::endl;
+    
+    PlateSystem plate(nx, ny);
+    int n = plate.K.n;
+    
+    // Double formats and their float32 copies, with and without 16-bit indices
+    BSRSolver::BSRMatrix Kb = BSRSolver::fromCSR(plate.K);
+    Float32Solver::CSRMatrix K32 = Float32Solver::fromCSR(plate.K);
+    Float32Solver::CSRMatrix K32s = Float32Solver::fromCSR(plate.K, true);
+    Float32Solver::BSRMatrix Kb32 = Float32Solver::fromBSR(Kb);
+    Float32Solver::BSRMatrix Kb32s = Float32Solver::fromBSR(Kb, true);
+    
+    std::vector<std::unique_ptr<LinearOperator>> ops;
+    ops.push_back(std::make_unique<CSROperator>(plate.K));
+    ops.push_back(std::make_unique<CSR32Operator>(K32));
+    ops.push_back(std::make_unique<CSR32Operator>(K32s));
+    ops.push_back(std::make_unique<BSROperator>(Kb));
+    ops.push_back(std::make_unique<BSR32Operator>(Kb32));
+    ops.push_back(std::make_unique<BSR32Operator>(Kb32s));
+    std::string labels[] = {"CSR fp64", "CSR fp32", "CSR fp32/i16", "BSR fp64", "BSR fp32", "BSR fp32/i16"};
+    
+    std::cout << "Mesh: " << nx << " x " << ny << ", DOF: " << n << ", nnz: " << plate.K.values.size()
+              << ", 16-bit indices: CSR " << (K32s.shortIndices ? "yes" : "no (bandwidth too large)")
+              << ", BSR " << (Kb32s.shortIndices ? "yes" : "no (bandwidth too large)") << std::endl;
+    
+    // SpMV alone: storage, time, bandwidth
+    const int repeats = 50;
+    std::vector<double> x = testVector(n), y(n);
+    std::vector<double> spmvTimes(ops.size());
+    for (size_t f = 0; f < ops.size(); f++) {
+        spmvTimes[f] = Benchmark::measureTime([&]() {
+            for (int r = 0; r < repeats; r++) ops[f]->apply(x, y);
+        }) / repeats;
+    }
+    
+    std::cout << "\n" << std::string(72, '=') << std::endl;
+    std::cout << "SPMV" << std::endl;
+    std::cout << std::string(72, '=') << std::endl;
+    std::cout << std::left << std::setw(16) << "Format"
+              << std::right << std::setw(14) << "Storage (MB)"
+              << std::setw(14) << "SpMV (ms)"
+              << std::setw(12) << "GB/s"
+              << std::setw(12) << "Speedup" << std::endl;
+    std::cout << std::string(72, '-') << std::endl;
+    for (size_t f = 0; f < ops.size(); f++) {
+        double bytes = ops[f]->memoryBytes() + 2.0 * n * sizeof(double);
+        std::cout << std::left << std::setw(16) << labels[f] << std::right
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(14) << ops[f]->memoryBytes() / (1024.0 * 1024.0)
+                  << std::setw(14) << spmvTimes[f] * 1e3
+                  << std::setprecision(2) << std::setw(12) << bytes / spmvTimes[f] * 1e-9
+                  << std::setw(11) << spmvTimes[0] / spmvTimes[f] << "x" << std::endl;
+    }
+    
+    // CG on every load case; accuracy is measured against the double K
+    const BoundaryConditions::LoadCase cases[] = {
+        BoundaryConditions::UNIFORM_5KN, BoundaryConditions::UNIFORM_10KN,
+        BoundaryConditions::LINEAR_VARYING, BoundaryConditions::CONCENTRATED_15KN,
+        BoundaryConditions::ANGLED_10KN
+    };
+    
+    std::vector<std::vector<double>> loads(5);
+    for (int c = 0; c < 5; c++) loads[c] = plate.load(cases[c]);
+    
+    std::ofstream file("results/float32.dat");
+    file << "# LoadCase Format StorageMB SpMVTime(s) CGIterations CGTime(s) RelResidual RelError" << std::endl;
+    
+    std::cout << "\n" << std::string(96, '=') << std::endl;
+    std::cout << "CG WITH FLOAT32 MATRIX STORAGE (vectors and reductions in double)" << std::endl;
+    std::cout << std::string(96, '=') << std::endl;
+    std::cout << std::left << std::setw(6) << "Case"
+              << std::setw(16) << "Format"
+              << std::right << std::setw(10) << "CG iters"
+              << std::setw(12) << "CG (s)"
+              << std::setw(10) << "Speedup"
+              << std::setw(20) << "||KU-F|| / ||F||"
+              << std::setw(22) << "||U-U64|| / ||U64||" << std::endl;
+    std::cout << std::string(96, '-') << std::endl;
+    
+    for (int c = 0; c < 5; c++) {
+        const std::vector<double>& F = loads[c];
+        double normF = std::sqrt(ConjugateGradientSolver::dotProduct(F, F));
+        
+        std::vector<double> reference;
+        double referenceTime = 0.0;
+        for (size_t f = 0; f < ops.size(); f++) {
+            std::vector<double> U;
+            int iterations = 0;
+            double cgTime = Benchmark::measureTime([&]() {
+                U = SparseSolver::sparseCG(*ops[f], F, false, &iterations);
+            });
+            if (f == 0) {
+                reference = U;
+                referenceTime = cgTime;
+            }
+            
+            // True residual with the double matrix, error against the double CSR solution
+            double residual = residualNorm(plate.K, U, F) / normF;
+            double error = 0.0, normU = 0.0;
+            for (int i = 0; i < n; i++) {
+                error += (U[i] - reference[i]) * (U[i] - reference[i]);
+                normU += reference[i] * reference[i];
+            }
+            error = std::sqrt(error / normU);
+            
+            std::cout << std::left << std::setw(6) << static_cast<int>(cases[c])
+                      << std::setw(16) << labels[f] << std::right
+                      << std::setw(10) << iterations
+                      << std::fixed << std::setprecision(4) << std::setw(12) << cgTime
+                      << std::setprecision(2) << std::setw(9) << referenceTime / cgTime << "x"
+                      << std::scientific << std::setprecision(3) << std::setw(20) << residual
+                      << std::setw(22) << error << std::endl;
+            
+            std::string format = labels[f];
+            std::replace(format.begin(), format.end(), ' ', '_');
+            file << static_cast<int>(cases[c]) << " " << format << " " << ops[f]->memoryBytes() / (1024.0 * 1024.0)
+                 << " " << spmvTimes[f] << " " << iterations << " " << cgTime << " " << residual << " "
+                 << error << std::endl;
+        }
+        std::cout << std::string(96, '-') << std::endl;
+    }
+    
+    std::cout << "Results exported to: results/float32.dat" << std::endl;
+}
+
+void PerformanceStudies::multicolorSORStudy(int nx, int ny, int maxThreads) {
+    CoutFormatGuard coutFormat;
+    std::cout << "\n=== STUDY: MULTICOLOR GAUSS-SEIDEL / SOR ===" << std::endl;
+    
+    PlateSystem plate(nx, ny);
+    CSROperator op(plate.K);
+    int n = plate.K.n;
+    
+    MulticolorSOR coloring(plate.K);
+    std::cout << "Mesh: " << nx << " x " << ny << ", DOF: " << n << ", colors: " << coloring.getNumColors()
+              << " (rows per color:";
+    for (int c = 0; c < coloring.getNumColors(); c++) std::cout << " " << coloring.colorSize(c);
+    std::cout << ")" << std::endl;
+    
+    // Sweep time against threads
+    const int sweeps = 50;
+    std::vector<int> threadCounts;
+    for (int t = 1; t < maxThreads; t *= 2) threadCounts.push_back(t);
+    threadCounts.push_back(maxThreads);
+    
+    std::ofstream sweepFile("results/multicolor_sweep.dat");
+    sweepFile << "# Threads SweepTime(s) Speedup" << std::endl;
+    
+    std::cout << "\n" << std::string(50, '=') << std::endl;
+    std::cout << "MULTICOLOR SOR SWEEP (" << sweeps << " sweeps)" << std::endl;
+    std::cout << std::string(50, '=') << std::endl;
+    std::cout << std::setw(10) << "Threads" << std::setw(18) << "Sweep (ms)" << std::setw(14) << "Speedup" << std::endl;
+    std::cout << std::string(50, '-') << std::endl;
+    
+    double serialSweep = 0.0;
+    for (int threads : threadCounts) {
+        MulticolorSOR sor(plate.K, 1.0, threads);
+        std::vector<double> x(n, 0.0);
+        double sweepTime = Benchmark::measureTime([&]() {
+            for (int s = 0; s < sweeps; s++) sor.sweep(plate.F, x);
+        }) / sweeps;
+        if (threads == 1) serialSweep = sweepTime;
+        
+        std::cout << std::setw(10) << threads << std::fixed << std::setprecision(3)
+                  << std::setw(18) << sweepTime * 1e3
+                  << std::setprecision(2) << std::setw(13) << serialSweep / sweepTime << "x" << std::endl;
+        sweepFile << threads << " " << sweepTime << " " << serialSweep / sweepTime << std::endl;
+    }
+    std::cout << std::string(50, '=') << std::endl;
+    
+    struct Row {
+        std::string method;
+        double omega;
+        int iterations;
+        double time, residual;
+    };
+    std::vector<Row> rows;
+    // Stationary SOR: residual after a fixed number of sweeps for several omega
+    const int stationarySweeps = 200;
+    for (double omega : {1.0, 1.2, 1.5, 1.8, 1.9}) {
+        MulticolorSOR sor(plate.K, omega, maxThreads);
+        Row row = {"SOR (" + std::to_string(stationarySweeps) + " sweeps)", omega, 0, 0.0, 0.0};
+        std::vector<double> U;
+        row.time = Benchmark::measureTime([&]() {
+            U = sor.solve(plate.F, false, &row.iterations, 1e-8, stationarySweeps);
+        });
+        row.residual = residualNorm(plate.K, U, plate.F);
+        rows.push_back(row);
+    }
+    
+    // As a CG preconditioner, against row-order SSOR
+    {
+        Row row = {"PCG (row-order SSOR)", 1.0, 0, 0.0, 0.0};
+        std::vector<double> U;
+        row.time = Benchmark::measureTime([&]() {
+            SSORPreconditioner M(plate.K);
+            U = SparseSolver::preconditionedCG(op, &M, plate.F, false, &row.iterations);
+        });
+        row.residual = residualNorm(plate.K, U, plate.F);
+        rows.push_back(row);
+    }
+    for (double omega : {1.0, 1.5}) {
+        Row row = {"PCG (multicolor SSOR)", omega, 0, 0.0, 0.0};
+        std::vector<double> U;
+        row.time = Benchmark::measureTime([&]() {
+            MulticolorSOR M(plate.K, omega, maxThreads);
+            U = SparseSolver::preconditionedCG(op, &M, plate.F, false, &row.iterations);
+        });
+        row.residual = residualNorm(plate.K, U, plate.F);
+        rows.push_back(row);
+    }
+    
+    // As the multigrid smoother
+    for (bool multicolor : {false, true}) {
+        Row row = {multicolor ? "PCG (GMG, multicolor GS)" : "PCG (GMG, row-order GS)", 1.0, 0, 0.0, 0.0};
+        std::vector<double> U;
+        row.time = Benchmark::measureTime([&]() {
+            GeometricMultigrid mg(plate.mesh, plate.K, plate.bc.getFixedDOFs());
+            if (multicolor) mg.setMulticolorSmoother(maxThreads);
+            U = SparseSolver::preconditionedCG(op, &mg, plate.F, false, &row.iterations);
+        });
+        row.residual = residualNorm(plate.K, U, plate.F);
+        rows.push_back(row);
+    }
+    
+    std::cout << "\n" << std::string(86, '=') << std::endl;
+    std::cout << "SOR AS SOLVER, PRECONDITIONER AND SMOOTHER (" << maxThreads << " threads, setup included)" << std::endl;
+    std::cout << std::string(86, '=') << std::endl;
+    std::cout << std::left << std::setw(28) << "Method"
+              << std::right << std::setw(8) << "Omega"
+              << std::setw(14) << "Iterations"
+              << std::setw(14) << "Time (s)"
+              << std::setw(16) << "||KU - F||" << std::endl;
+    std::cout << std::string(86, '-') << std::endl;
+    
+    std::ofstream file("results/multicolor_sor.dat");
+    file << "# Method Omega Iterations Time(s) Residual" << std::endl;
+    
+    for (const auto& row : rows) {
+        std::cout << std::left << std::setw(28) << row.method << std::right
+                  << std::fixed << std::setprecision(2) << std::setw(8) << row.omega
+                  << std::setw(14) << row.iterations
+                  << std::setprecision(4) << std::setw(14) << row.time
+                  << std::scientific << std::setprecision(3) << std::setw(16) << row.residual << std::endl;
+        
+        std::string method = row.method;
+        std::replace(method.begin(), method.end(), ' ', '_');
+        file << method << " " << row.omega << " " << row.iterations << " " << row.time << " "
+             << row.residual << std::endl;
+    }
+    
+    std::cout << std::string(86, '=') << std::endl;
+    std::cout << "Results exported to: results/multicolor_sweep.dat, results/multicolor_sor.dat" << std::endl;
+}
+
+void PerformanceStudies::pipelinedCGStudy(int nx, int ny, int maxThreads) {
+    CoutFormatGuard coutFormat;
+    std::cout << "\n=== STUDY: PIPELINED CG ===" << std::endl;
+    
+    PlateSystem plate(nx, ny, true, maxThreads);
+    int n = plate.K.n;
+    
+    // Convergence to |r| < 1e-8 on maxThreads threads
+    struct Run {
+        std::string method;
+        int replacementInterval;  // -1 for classical CG
+        int iterations;
+        double time;
+        double residual;
+    };
+    std::vector<Run> runs = {{"Classical CG", -1, 0, 0.0, 0.0},
+                             {"Pipelined CG", 0, 0, 0.0, 0.0},
+                             {"Pipelined CG", 200, 0, 0.0, 0.0},
+                             {"Pipelined CG", 50, 0, 0.0, 0.0},
+                             {"Pipelined CG", 20, 0, 0.0, 0.0}};
+    
+    for (auto& run : runs) {
+        std::vector<double> U;
+        run.time = Benchmark::measureTime([&]() {
+            U = run.replacementInterval < 0
+                ? SparseSolver::parallelCG(plate.K, plate.F, maxThreads, false, &run.iterations)
+                : SparseSolver::pipelinedCG(plate.K, plate.F, maxThreads, false, &run.iterations, run.replacementInterval);
+        });
+        run.residual = residualNorm(plate.K, U, plate.F);
+    }
+    
+    std::cout << "\n" << std::string(80, '=') << std::endl;
+    std::cout << "CONVERGENCE (" << nx << " x " << ny << " elements, " << n << " DOF, "
+              << maxThreads << " threads)" << std::endl;
+    std::cout << std::string(80, '=') << std::endl;
+    std::cout << std::left << std::setw(20) << "Method"
+              << std::right << std::setw(14) << "Replacement"
+              << std::setw(12) << "Iterations"
+              << std::setw(14) << "Time (s)"
+              << std::setw(18) << "True ||KU - F||" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    
+    std::ofstream file("results/pipelined_cg.dat");
+    file << "# Method ReplacementInterval Iterations Time(s) TrueResidual" << std::endl;
+    
+    for (const auto& run : runs) {
+        std::string interval = run.replacementInterval < 0 ? "-"
+                             : run.replacementInterval == 0 ? "off" : std::to_string(run.replacementInterval);
+        std::cout << std::left << std::setw(20) << run.method
+                  << std::right << std::setw(14) << interval
+                  << std::setw(12) << run.iterations
+                  << std::fixed << std::setprecision(4) << std::setw(14) << run.time
+                  << std::scientific << std::setprecision(3) << std::setw(18) << run.residual << std::endl;
+        
+        std::string method = run.method;
+        std::replace(method.begin(), method.end(), ' ', '_');
+        file << method << " " << run.replacementInterval << " " << run.iterations << " " << run.time << " "
+             << run.residual << std::endl;
+    }
+    std::cout << std::string(80, '=') << std::endl;
+    
+    // Time per iteration over a fixed count, so both variants do the same work
+    const int cgIterations = 200;
+    
+    std::cout << "\n" << std::string(86, '=') << std::endl;
+    std::cout << "SCALING (" << cgIterations << " iterations, no replacement)" << std::endl;
+    std::cout << std::string(86, '=') << std::endl;
+    std::cout << std::right << std::setw(8) << "Threads"
+              << std::setw(18) << "Classical (ms/it)"
+              << std::setw(12) << "Speedup"
+              << std::setw(18) << "Pipelined (ms/it)"
+              << std::setw(12) << "Speedup"
+              << std::setw(18) << "Pipelined gain" << std::endl;
+    std::cout << std::string(86, '-') << std::endl;
+    
+    std::ofstream scalingFile("results/pipelined_cg_scaling.dat");
+    scalingFile << "# Threads ClassicalPerIteration(s) ClassicalSpeedup PipelinedPerIteration(s) PipelinedSpeedup "
+                << "PipelinedGain" << std::endl;
+    
+    double classicalSerial = 0.0, pipelinedSerial = 0.0;
+    for (int threads : threadCounts(maxThreads)) {
+        double classical = Benchmark::measureTime([&]() {
+            SparseSolver::parallelCG(plate.K, plate.F, threads, false, nullptr, cgIterations);
+        }) / cgIterations;
+        double pipelined = Benchmark::measureTime([&]() {
+            SparseSolver::pipelinedCG(plate.K, plate.F, threads, false, nullptr, 0, cgIterations);
+        }) / cgIterations;
+        if (threads == 1) {
+            classicalSerial = classical;
+            pipelinedSerial = pipelined;
+        }
+        
+        std::cout << std::setw(8) << threads
+                  << std::fixed << std::setprecision(3) << std::setw(18) << classical * 1e3
+                  << std::setprecision(2) << std::setw(11) << classicalSerial / classical << "x"
+                  << std::setprecision(3) << std::setw(18) << pipelined * 1e3
+                  << std::setprecision(2) << std::setw(11) << pipelinedSerial / pipelined << "x"
+                  << std::setw(17) << classical / pipelined << "x" << std::endl;
+        
+        scalingFile << threads << " " << classical << " " << classicalSerial / classical << " " << pipelined << " "
+                    << pipelinedSerial / pipelined << " " << classical / pipelined << std::endl;
+    }
+    
+    std::cout << std::string(86, '=') << std::endl;
+    std::cout << "Results exported to: results/pipelined_cg.dat, results/pipelined_cg_scaling.dat" << std::endl;
+}
+
+bool PerformanceStudies::run(const std::string& name, int nx, int ny, int maxThreads) {
+    if (name == "assembly") {
+        assemblyScaling(nx, ny, maxThreads);
+    } else if (name == "kernel") {
+        elementKernelBenchmark(nx, ny);
+    } else if (name == "batch") {
+        batchedKernelStudy(nx, ny);
+    } else if (name == "cache") {
+        elementCacheStudy(nx, ny);
+    } else if (name == "matrixfree") {
+        matrixFreeStudy(nx, ny, maxThreads);
+    } else if (name == "stencil") {
+        stencilStudy(nx, ny, maxThreads);
+    } else if (name == "rcm") {
+        nodeOrderingStudy(nx, ny);
+    } else if (name == "skyline") {
+        skylineStudy(nx, ny);
+    } else if (name == "cholesky") {
+        sparseCholeskyStudy(nx, ny);
+    } else if (name == "pcg") {
+        preconditionerStudy(nx, ny);
+    } else if (name == "multigrid") {
+        multigridStudy(nx, ny);
+    } else if (name == "amg") {
+        algebraicMultigridStudy(nx, ny);
+    } else if (name == "multirhs") {
+        multipleRHSStudy(nx, ny);
+    } else if (name == "dense") {
+        denseFactorizationStudy(nx, ny);
+    } else if (name == "tiled") {
+        tiledFactorizationScaling(nx, ny, maxThreads);
+    } else if (name == "parallelcg") {
+        parallelCGScaling(nx, ny, maxThreads);
+    } else if (name == "bsr") {
+        blockSparseStudy(nx, ny);
+    } else if (name == "sell") {
+        slicedEllpackStudy(nx, ny);
+    } else if (name == "float32") {
+        float32StorageStudy(nx, ny);
+    } else if (name == "multicolor") {
+        multicolorSORStudy(nx, ny, maxThreads);
+    } else if (name == "pipelined") {
+        pipelinedCGStudy(nx, ny, maxThreads);
+    } else {
+        std::cerr << "Unknown study: " << name << std::endl;
+        std::cerr << "Available studies: assembly, kernel, batch, cache, matrixfree, stencil, rcm, skyline, cholesky, pcg, multigrid, amg, multirhs, dense, tiled, parallelcg, bsr, sell, float32, multicolor, pipelined" << std::endl;
+        return false;
+    }
+    return true;
+}
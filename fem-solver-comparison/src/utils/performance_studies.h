@@ -0,0 +1,133 @@
+#ifndef PERFORMANCE_STUDIES_H
+#define PERFORMANCE_STUDIES_H
+
+#include <string>
+#include <vector>
+#include "../matrix/stiffness_matrix.h"
+#include "../fem/boundary_conditions.h"
+#include "../solvers/efficient_solver.h"
+
+// Stand-alone performance studies selected with --study=<name> on the command line
+class PerformanceStudies {
+public:
+    // Material of the benchmark plate (steel, 5 mm)
+    static StiffnessMatrix::MaterialProperties steelPlate();
+    
+    // Thread counts 1, 2, 4, ... up to and including maxThreads
+    static std::vector<int> threadCounts(int maxThreads);
+    
+    // Benchmark plate of nx x ny steel elements with the left edge fixed: the mesh
+    // (RCM-renumbered unless rcm is false), CSR K with the boundary conditions
+    // applied and the matching load vector F. numThreads = 0 leaves K unassembled
+    // for studies that only need assembleDense()
+    struct PlateSystem {
+        StiffnessMatrix mesh;
+        BoundaryConditions bc;
+        SparseSolver::SparseMatrix K;
+        std::vector<double> F;
+        
+        PlateSystem(int nx, int ny, bool rcm = true, int numThreads = 1,
+                    BoundaryConditions::LoadCase loadCase = BoundaryConditions::UNIFORM_5KN);
+        PlateSystem(const PlateSystem&) = delete;   // bc refers to this mesh
+        
+        // Reassemble K from the mesh and apply the boundary conditions again
+        void assemble(int numThreads = 1);
+        
+        // Dense K with the boundary conditions applied
+        DenseMatrix assembleDense();
+        
+        // Load vector of another case, zero at the fixed DOFs like F
+        std::vector<double> load(BoundaryConditions::LoadCase loadCase);
+    };
+    
+    // Meshes nx/8 x ny/8 up to nx x ny, each twice as fine as the one before
+    static std::vector<std::pair<int, int>> refinementSequence(int nx, int ny);
+    
+    // Smooth, nonzero vector 1 + 0.5 sin(i) for comparing products between formats
+    static std::vector<double> testVector(int n);
+    
+    // max |y - reference| / max |reference|
+    static double maxRelativeDifference(const std::vector<double>& y, const std::vector<double>& reference);
+    
+    // ||F - K U||_2
+    static double residualNorm(const SparseSolver::SparseMatrix& K, const std::vector<double>& U,
+                               const std::vector<double>& F);
+    
+    // Colored parallel assembly: scaling from 1 to maxThreads, bitwise check against the
+    // colored order on 1 thread and max difference from serial element-order assembly
+    static void assemblyScaling(int nx, int ny, int maxThreads);
+    
+    // Element stiffness evaluations per second: heap-matrix reference vs fixed-size kernel
+    static void elementKernelBenchmark(int nx, int ny);
+    
+    // Scalar vs SIMD-batched element kernel on an irregular mesh: Ke evaluations per
+    // second and uncached CSR assembly time
+    static void batchedKernelStudy(int nx, int ny);
+    
+    // Ke cache hit rates and assembly time on uniform and mildly irregular meshes
+    static void elementCacheStudy(int nx, int ny);
+    
+    // Matrix-free K*x vs assembled CSR: memory, time per product and CG solve
+    static void matrixFreeStudy(int nx, int ny, int numThreads);
+    
+    // Constant-coefficient stencil K*x vs CSR sparseMatVecMult, and CG on both
+    static void stencilStudy(int nx, int ny, int numThreads);
+    
+    // Row-major vs reverse Cuthill-McKee node numbering: envelope, SpMV and CG time
+    static void nodeOrderingStudy(int nx, int ny);
+    
+    // Skyline LDL^T vs sparse CG, with row-major and RCM numbering
+    static void skylineStudy(int nx, int ny);
+    
+    // Supernodal sparse Cholesky (natural and nested-dissection order) vs skyline and CG:
+    // fill, flops and time per phase
+    static void sparseCholeskyStudy(int nx, int ny);
+    
+    // Plain CG vs Jacobi, SSOR and IC(0) preconditioned CG on successively refined meshes
+    static void preconditionerStudy(int nx, int ny);
+    
+    // Geometric multigrid V-cycles and MG-preconditioned CG vs IC(0)-CG under refinement
+    static void multigridStudy(int nx, int ny);
+    
+    // Smoothed-aggregation AMG vs geometric multigrid as CG preconditioners: hierarchy,
+    // setup time, and solve time per load case with the hierarchy reused
+    static void algebraicMultigridStudy(int nx, int ny);
+    
+    // k separate SpMVs / CG solves vs one block SpMV / batched CG over k load vectors
+    static void multipleRHSStudy(int nx, int ny);
+    
+    // Unblocked vs blocked (GEMM-based) dense LU and Cholesky: GFLOP/s and residuals on
+    // meshes up to nx/8 x ny/8 (dense K grows as DOF^2), plus a panel-width sweep
+    static void denseFactorizationStudy(int nx, int ny);
+    
+    // Task-parallel tiled LU and Cholesky on the nx/6 x ny/6 mesh: strong scaling
+    // from 1 to maxThreads against the serial blocked factorizations
+    static void tiledFactorizationScaling(int nx, int ny, int maxThreads);
+    
+    // Parallel CSR SpMV and CG from 1 to maxThreads with nnz-balanced row ranges, on the
+    // requested mesh enlarged to at least 10^6 DOF; CG is timed over a fixed iteration count
+    static void parallelCGScaling(int nx, int ny, int maxThreads);
+    
+    // 2x2 block CSR vs scalar CSR: storage, SpMV bandwidth and CG time
+    static void blockSparseStudy(int nx, int ny);
+    
+    // SELL-C-sigma vs CSR and BSR: padding for several sigma, SpMV bandwidth and CG time
+    static void slicedEllpackStudy(int nx, int ny);
+    
+    // Float32 CSR/BSR values (and 16-bit indices) vs double: SpMV time, CG iterations,
+    // time and accuracy on every load case
+    static void float32StorageStudy(int nx, int ny);
+    
+    // Multicolor Gauss-Seidel/SOR: coloring, sweep scaling, omega, and use as a CG
+    // preconditioner and multigrid smoother
+    static void multicolorSORStudy(int nx, int ny, int maxThreads);
+    
+    // Pipelined CG vs parallelCG: iterations and accuracy for several residual
+    // replacement intervals, then time per iteration from 1 to maxThreads
+    static void pipelinedCGStudy(int nx, int ny, int maxThreads);
+    
+    // Run a study by name; returns false if the name is unknown
+    static bool run(const std::string& name, int nx, int ny, int maxThreads);
+};
+
+#endif